@@ -7,21 +7,80 @@ void ofApp::setup()
 	ofDisableArbTex();
 	ofBackground(ofColor::black);
 
-	this->stepper = 0.0f;
+	// Oscillate the cube size within its range.
+	this->modulation.add(this->cubeSize, this->parameters.mesh.sizeModulator);
+	this->history.add(this->cubeSize);
+
+	// Decode images in the background whenever the path changes.
+	this->imageListener = this->assetLoader.loadedE.newListener([this](const ofxPreset::AssetLoader::Asset & asset)
+	{
+		this->imageLoaded(asset);
+	});
+	this->assetLoader.bind(this->parameters.render.imagePath);
+
+	// Track changes to know when the settings are modified.
+	this->hashTree.setup(this->parameters);
 
 	// Load default settings, if any.
 	this->loadSettings("defaults.json");
 
+	// Recover any changes made before a crash, and keep track of new ones.
+	this->journal.setup(this->parameters, "journal");
+
+	// Link parameters to expressions of other parameters, e.g. {/App/Mesh/Size Min} * 4.
+	this->expressions.setup(this->parameters);
+	ofFile expressionsFile("expressions.json");
+	if (expressionsFile.exists())
+	{
+		nlohmann::json json;
+		expressionsFile >> json;
+		ofxPreset::Serializer::Deserialize(json, this->expressions);
+	}
+
+	// Glide to loaded settings, colors take a little longer.
+	this->slew.setup(this->parameters, 1.0f);
+	this->slew.setDuration(this->parameters.colors, 2.0f);
+
+	// Generate color variations, and keep the good ones.
+	this->colorStore.setup(this->parameters.colors);
+	this->colorVariations.setup(this->colorStore);
+	this->colorVariations.setSeed(ofGetSystemTimeMillis());
+	this->colorBank.setup(this->colorStore);
+	this->colorBank.load("colors.bank");
+	this->colorSimilarity.setup(this->colorBank, this->colorStore);
+
 	// GUI
 	this->gui.setup();
+
+	// Changing the size range re-centers the cube, only do it once done dragging.
+	ofxPreset::Gui::SetCommitPolicy(this->parameters.mesh.sizeMin, ofxPreset::Gui::CommitMode::OnRelease);
+	ofxPreset::Gui::SetCommitPolicy(this->parameters.mesh.sizeMax, ofxPreset::Gui::CommitMode::OnRelease);
+	this->searchIndex.setup(this->parameters);
+	this->profiler.setup(this->parameters);
 	this->guiVisible = true;
 }
 
 //--------------------------------------------------------------
 void ofApp::update()
 {
-	this->stepper += this->parameters.mesh.speed;
-	cubeSize = ofMap(sinf(this->stepper), -1.0f, 1.0f, this->parameters.mesh.sizeMin, this->parameters.mesh.sizeMax);
+	this->assetLoader.update();
+	this->journal.update();
+
+	// Advance the transitions first, so linked expressions follow along.
+	this->slew.update();
+
+	// Only re-evaluates the expressions whose inputs changed.
+	this->expressions.update();
+
+	// Modulate around the middle of the size range.
+	if (this->cubeSize.getMin() != this->parameters.mesh.sizeMin || this->cubeSize.getMax() != this->parameters.mesh.sizeMax)
+	{
+		this->cubeSize.setMin(this->parameters.mesh.sizeMin);
+		this->cubeSize.setMax(this->parameters.mesh.sizeMax);
+		this->cubeSize = (this->parameters.mesh.sizeMin + this->parameters.mesh.sizeMax) * 0.5f;
+	}
+	this->modulation.update();
+	this->history.update();
 	
 	if (this->guiVisible || this->parameters.camera.mouseEnabled)
 	{
@@ -100,6 +159,13 @@ void ofApp::draw()
 	}
 }
 
+//--------------------------------------------------------------
+void ofApp::exit()
+{
+	// Clean exit, nothing to recover next time.
+	this->journal.discard();
+}
+
 //--------------------------------------------------------------
 void ofApp::keyPressed(int key){
 
@@ -189,25 +255,32 @@ void ofApp::saveCamera()
 }
 
 //--------------------------------------------------------------
-bool ofApp::loadImage(const string & filePath)
+void ofApp::imageLoaded(const ofxPreset::AssetLoader::Asset & asset)
 {
-	ofImage image;
-	image.setUseTexture(false);
-	if (!image.load(filePath)) {
-		ofLogError("ofApp::loadImage") << "No image found at " << filePath;
-		return false;
+	if (asset.path != this->parameters.render.imagePath.get())
+	{
+		// Stale, the path changed again while this one was loading.
+		return;
+	}
+	if (!asset.pixels)
+	{
+		ofLogError("ofApp::imageLoaded") << "No image found at " << asset.path;
+		return;
+	}
+	if (asset.pixels == this->texturePixels)
+	{
+		// Already uploaded.
+		return;
 	}
 
 	ofTextureData texData;
-	texData.width = image.getWidth();
-	texData.height = image.getHeight();
+	texData.width = asset.pixels->getWidth();
+	texData.height = asset.pixels->getHeight();
 	texData.textureTarget = GL_TEXTURE_2D;
 	texData.bFlipTexture = true;
 	this->texture.allocate(texData);
-	this->texture.loadData(image.getPixels());
-
-	this->parameters.render.imagePath = ofFilePath::makeRelative(ofToDataPath(""), filePath);
-	return true;
+	this->texture.loadData(*asset.pixels);
+	this->texturePixels = asset.pixels;
 }
 
 //--------------------------------------------------------------
@@ -220,6 +293,10 @@ bool ofApp::imGui()
 		if (ofxPreset::Gui::BeginWindow(this->parameters.getName(), mainSettings))
 		{
 			ImGui::Text("%.1f FPS (%.3f ms/frame)", ofGetFrameRate(), 1000.0f / ImGui::GetIO().Framerate);
+			if (!this->hashTree.equals(this->savedSnapshot))
+			{
+				ImGui::Text("Settings modified");
+			}
 
 			if (ImGui::Button("Save All..."))
 			{
@@ -235,12 +312,64 @@ bool ofApp::imGui()
 				auto dialogResult = ofSystemLoadDialog("Load Settings", false, ofToDataPath("settings"));
 				if (dialogResult.bSuccess)
 				{
-					this->loadSettings(dialogResult.filePath);
+					this->loadSettings(dialogResult.filePath, true);
 				}
 			}
 
             ofxPreset::Gui::AddGroup(this->parameters.colors, mainSettings);
 
+			if (ImGui::CollapsingHeader("Variations", nullptr, true, false))
+			{
+				// Every click draws new variants, the seed shown below brings a batch back.
+				if (ImGui::Button("Mutate"))
+				{
+					this->colorVariations.setSeed(this->colorVariations.getSeed() + 1);
+					this->colorVariations.mutate(8, 0.25f);
+				}
+				ImGui::SameLine();
+				if (ImGui::Button("Randomize"))
+				{
+					this->colorVariations.setSeed(this->colorVariations.getSeed() + 1);
+					this->colorVariations.randomize(8);
+				}
+				ImGui::SameLine();
+				if (ImGui::Button("Restore"))
+				{
+					this->colorVariations.restore();
+				}
+				ImGui::Text("Seed %llu", static_cast<unsigned long long>(this->colorVariations.getSeed()));
+
+				for (size_t i = 0; i < this->colorVariations.size(); ++i)
+				{
+					ImGui::PushID(static_cast<int>(i));
+					if (ImGui::Button(("Preview " + ofToString(i)).c_str()))
+					{
+						this->colorVariations.preview(i);
+					}
+					ImGui::SameLine();
+					if (ImGui::Button("Keep") && this->colorSimilarity.findDuplicate(this->colorVariations.getValues(i)) < 0)
+					{
+						this->colorVariations.save(i, this->colorBank, "Colors " + ofToString(this->colorBank.size()));
+						this->colorBank.save("colors.bank");
+						this->colorSimilarity.setup(this->colorBank, this->colorStore);
+					}
+					ImGui::PopID();
+				}
+
+				// List the kept colors closest to the current ones first.
+				this->colorSimilarity.search(this->colorStore, this->colorBank.size(), this->similarColors);
+				for (const auto & result : this->similarColors)
+				{
+					const auto label = this->colorBank.getName(result.index) + " (" + ofToString(result.distance, 2) + ")";
+					if (ImGui::Selectable(label.c_str()))
+					{
+						ofxPreset::Store::Snapshot snapshot;
+						this->colorBank.get(result.index, snapshot);
+						this->colorStore.apply(snapshot);
+					}
+				}
+			}
+
 			if (ImGui::CollapsingHeader(this->parameters.camera.getName().c_str(), nullptr, true, true))
 			{
 				if (ofxPreset::Gui::AddParameter(this->parameters.camera.mouseEnabled))
@@ -272,20 +401,13 @@ bool ofApp::imGui()
 			{
 				ofxPreset::Gui::AddParameter(this->parameters.mesh.enabled);
 				ofxPreset::Gui::AddRange("Size Range", this->parameters.mesh.sizeMin, this->parameters.mesh.sizeMax, 1.0f);
-				ofxPreset::Gui::AddParameter(this->parameters.mesh.speed);
-				ImGui::Text("Size: %.2f", this->cubeSize);
+				ofxPreset::Gui::AddModulator(this->parameters.mesh.sizeModulator, mainSettings);
+				ofxPreset::Gui::AddHistory(this->history, this->cubeSize);
 			}
 
 			if (ImGui::CollapsingHeader(this->parameters.render.getName().c_str(), nullptr, true, true))
 			{
-				if (ImGui::Button("Load Image..."))
-				{
-					auto dialogResult = ofSystemLoadDialog("Load Image", false, ofToDataPath(""));
-					if (dialogResult.bSuccess)
-					{
-						this->loadImage(dialogResult.filePath);
-					}
-				}
+				ofxPreset::Gui::AddParameter(this->parameters.render.imagePath);
 
 				static vector<string> labels = { "None", "Color", "Texture" };
 
@@ -308,6 +430,29 @@ bool ofApp::imGui()
 					ofxPreset::Gui::AddParameter(this->parameters.render.preview);
 				}
 			}
+
+			if (ImGui::CollapsingHeader("Expressions", nullptr, true, false))
+			{
+				ofxPreset::Gui::AddExpressions(this->expressions, mainSettings);
+				if (ImGui::Button("Save Expressions"))
+				{
+					nlohmann::json json;
+					ofxPreset::Serializer::Serialize(json, this->expressions);
+
+					ofFile file("expressions.json", ofFile::WriteOnly);
+					file << json.dump(4);
+				}
+			}
+
+			if (ImGui::CollapsingHeader("Search", nullptr, true, false))
+			{
+				ofxPreset::Gui::AddSearch(this->searchIndex, mainSettings);
+			}
+
+			if (ImGui::CollapsingHeader("Profiler", nullptr, true, false))
+			{
+				ofxPreset::Gui::AddProfiler(this->profiler, mainSettings);
+			}
 		}
 		ofxPreset::Gui::EndWindow(mainSettings);
 
@@ -331,33 +476,41 @@ bool ofApp::imGui()
 }
 
 //--------------------------------------------------------------
-void ofApp::loadSettings(const string & filePath)
+void ofApp::loadSettings(const string & filePath, bool glide)
 {
-	ofFile file(filePath);
-	if (file.exists())
+	if (glide)
 	{
+		ofFile file(filePath);
+		if (!file.exists())
+		{
+			return;
+		}
 		nlohmann::json json;
 		file >> json;
 
-		ofxPreset::Serializer::Deserialize(json, this->parameters);
+		// Values are still gliding, compare against the file rather than the current values.
+		this->slew.deserialize(json);
+		this->loadCamera();
 
+		this->savedSnapshot = this->hashTree.getSnapshot(json);
+		return;
+	}
+
+	// Unchanged files are applied from a binary cache, skipping the JSON parsing.
+	// The image path is bound to the asset loader, which decodes it in the background if it changed.
+	if (ofxPreset::Serializer::DeserializeCached(filePath, this->parameters))
+	{
 		this->loadCamera();
 
-		if (!this->parameters.render.imagePath.get().empty())
-		{
-			this->loadImage(this->parameters.render.imagePath);
-		}
+		this->savedSnapshot = this->hashTree.getSnapshot();
 	}
 }
 
 //--------------------------------------------------------------
 void ofApp::saveSettings(const string & filePath)
 {
-	nlohmann::json json;
+	ofxPreset::Serializer::SerializeToFile(filePath, this->parameters);
 
-	ofxPreset::Serializer::Serialize(json, this->parameters);
-
-	ofFile file(filePath, ofFile::WriteOnly);
-	file << json.dump(4);
+	this->savedSnapshot = this->hashTree.getSnapshot();
 }
 
@@ -11,6 +11,7 @@ public:
 	void setup();
 	void update();
 	void draw();
+	void exit();
 
 	void keyPressed(int key);
 	void keyReleased(int key);
@@ -31,25 +32,43 @@ public:
 	ofEasyCam camera;
 
 	// Mesh
-	float stepper;
-	float cubeSize;
+	ofxPreset::Modulation modulation;
+	ofxPreset::History history;
+	ofParameter<float> cubeSize{ "Size", 105.0f, 10.0f, 200.0f };
 
 	// Render
-	bool loadImage(const string & filePath);
+	void imageLoaded(const ofxPreset::AssetLoader::Asset & asset);
 
+	ofxPreset::AssetLoader assetLoader;
+	ofEventListener imageListener;
 	ofTexture texture;
+	shared_ptr<const ofPixels> texturePixels;
 
 	// GUI
 	bool imGui();
 
 	ofxImGui gui;
+	ofxPreset::SearchIndex searchIndex;
+	ofxPreset::Profiler profiler;
 	bool guiVisible;
 	bool mouseOverGui;
 
 	// Parameters
-	void loadSettings(const string & filePath);
+	// Gliding loads blend from the current values, see slew.
+	void loadSettings(const string & filePath, bool glide = false);
 	void saveSettings(const string & filePath);
 
+	ofxPreset::Journal journal;
+	ofxPreset::Expressions expressions;
+	ofxPreset::Slew slew;
+	ofxPreset::Store colorStore;
+	ofxPreset::Variations colorVariations;
+	ofxPreset::Bank colorBank;
+	ofxPreset::SimilarityIndex colorSimilarity;
+	vector<ofxPreset::SimilarityIndex::Result> similarColors;
+	ofxPreset::HashTree hashTree;
+	ofxPreset::HashTree::Snapshot savedSnapshot;
+
 	enum RenderMode
 	{
 		RenderModeNone = 0,
@@ -80,9 +99,9 @@ public:
 			ofParameter<bool> enabled{ "Enabled", true };
 			ofParameter<float> sizeMin{ "Size Min", 10.0f, 0.0f, 1000.0f };
 			ofParameter<float> sizeMax{ "Size Max", 200.0f, 0.0f, 1000.0f };
-			ofParameter<float> speed{ "Speed", 0.1f, 0.0f, 1.0f };
+			ofxPreset::Modulator sizeModulator{ "Size Modulator" };
 
-			PARAM_DECLARE("Mesh", enabled, sizeMin, sizeMax, speed);
+			PARAM_DECLARE("Mesh", enabled, sizeMin, sizeMax, sizeModulator);
 		} mesh;
 
 		struct : ofParameterGroup
@@ -90,7 +109,7 @@ public:
 			ofParameter<int> fillMode{ "Fill Mode", RenderModeTexture };   // Auto-update because we're using radio buttons in the gui.
 			ofParameter<int> strokeMode{ "Stroke Mode", RenderModeNone };  // Auto-update because we're using radio buttons in the gui.
 			ofParameter<bool> preview{ "Preview", false };                 // Auto-update because we can close the window from its toolbar.
-			ofParameter<string> imagePath{ "Image Path", "texture.jpg" };
+			ofParameter<ofxPreset::AssetPath> imagePath{ "Image Path", ofxPreset::AssetPath("texture.jpg") };
 
 			PARAM_DECLARE("Render", fillMode, strokeMode, preview, imagePath);
 		} render;
@@ -1,7 +1,23 @@
 #pragma once
 
+#include "ofxPreset/AssetLoader.h"
+#include "ofxPreset/Bank.h"
+#include "ofxPreset/Bindings.h"
+#include "ofxPreset/Expressions.h"
 #include "ofxPreset/Gui.h"
+#include "ofxPreset/HashTree.h"
+#include "ofxPreset/History.h"
+#include "ofxPreset/Journal.h"
+#include "ofxPreset/Layers.h"
+#include "ofxPreset/Modulation.h"
+#include "ofxPreset/PackedBank.h"
+#include "ofxPreset/Profiler.h"
+#include "ofxPreset/SearchIndex.h"
 #include "ofxPreset/Serializer.h"
+#include "ofxPreset/SimilarityIndex.h"
+#include "ofxPreset/Slew.h"
+#include "ofxPreset/Store.h"
+#include "ofxPreset/Variations.h"
 
 // Stolen from ofxRulr, thanks Elliot!
 // Syntactic sugar which enables struct-ofParameterGroup
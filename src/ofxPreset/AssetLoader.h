@@ -0,0 +1,80 @@
+#pragma once
+
+#include <unordered_set>
+
+#include "ofEvents.h"
+#include "ofImage.h"
+#include "ofParameter.h"
+#include "ofThread.h"
+#include "ofThreadChannel.h"
+
+#include "AssetPath.h"
+
+namespace ofxPreset
+{
+	// Decodes images on a worker thread into a pixel cache keyed by path and modification time.
+	// Finished assets are handed back on the main thread in update(), through loadedE.
+	class AssetLoader
+		: public ofThread
+	{
+	public:
+		struct Asset
+		{
+			AssetPath path;
+			// Empty if the file could not be loaded.
+			shared_ptr<const ofPixels> pixels;
+		};
+
+		static const size_t kDefaultCacheSize = 256 * 1024 * 1024;
+
+		inline AssetLoader();
+		inline ~AssetLoader();
+
+		// Queues a decode, cached pixels are reused as long as the file has not changed on disk.
+		inline void load(const AssetPath & path);
+
+		// Loads the parameter's asset now and whenever its value changes.
+		inline void bind(ofParameter<AssetPath> & parameter);
+		inline void unbindAll();
+
+		// Call from the main thread, notifies loadedE for every finished asset and returns how many there were.
+		inline size_t update();
+
+		// Cached pixels for the path, without checking the file or waiting for a decode.
+		inline shared_ptr<const ofPixels> getPixels(const AssetPath & path);
+
+		// Least recently used pixels are dropped once the cache grows past this many bytes.
+		inline void setCacheSize(size_t numBytes);
+		inline void clearCache();
+
+		ofEvent<const Asset> loadedE;
+
+	protected:
+		struct Entry
+		{
+			shared_ptr<const ofPixels> pixels;
+			int64_t modified;
+			uint64_t lastUsed;
+			size_t numBytes;
+		};
+
+		static inline int64_t GetModifiedTime(const string & filePath);
+
+		inline void threadedFunction() override;
+		inline void trimCache();
+
+		ofThreadChannel<AssetPath> requests;
+		ofThreadChannel<Asset> results;
+		unordered_set<string> pending;
+
+		// Shared with the worker, guarded by the thread's mutex.
+		unordered_map<string, Entry> cache;
+		size_t cacheSize;
+		size_t cacheBytes;
+		uint64_t useCounter;
+
+		ofEventListeners listeners;
+	};
+}
+
+#include "AssetLoader.inl"
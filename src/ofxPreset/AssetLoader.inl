@@ -0,0 +1,182 @@
+#include "AssetLoader.h"
+
+#include <sys/stat.h>
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	int64_t AssetLoader::GetModifiedTime(const string & filePath)
+	{
+		struct stat fileStat;
+		if (stat(filePath.c_str(), &fileStat) != 0)
+		{
+			return -1;
+		}
+		return static_cast<int64_t>(fileStat.st_mtime);
+	}
+
+	//--------------------------------------------------------------
+	AssetLoader::AssetLoader()
+		: cacheSize(kDefaultCacheSize)
+		, cacheBytes(0)
+		, useCounter(0)
+	{
+		this->startThread();
+	}
+
+	//--------------------------------------------------------------
+	AssetLoader::~AssetLoader()
+	{
+		this->listeners.unsubscribeAll();
+		this->requests.close();
+		this->results.close();
+		this->waitForThread(true);
+	}
+
+	//--------------------------------------------------------------
+	void AssetLoader::load(const AssetPath & path)
+	{
+		if (path.empty())
+		{
+			return;
+		}
+
+		// Already on its way.
+		if (!this->pending.insert(path.path).second)
+		{
+			return;
+		}
+
+		this->requests.send(path);
+	}
+
+	//--------------------------------------------------------------
+	void AssetLoader::bind(ofParameter<AssetPath> & parameter)
+	{
+		this->listeners.push(parameter.newListener([this](AssetPath & path)
+		{
+			this->load(path);
+		}));
+
+		this->load(parameter.get());
+	}
+
+	//--------------------------------------------------------------
+	void AssetLoader::unbindAll()
+	{
+		this->listeners.unsubscribeAll();
+	}
+
+	//--------------------------------------------------------------
+	size_t AssetLoader::update()
+	{
+		size_t numLoaded = 0;
+		Asset asset;
+		while (this->results.tryReceive(asset))
+		{
+			this->pending.erase(asset.path.path);
+			this->loadedE.notify(asset);
+			++numLoaded;
+		}
+		return numLoaded;
+	}
+
+	//--------------------------------------------------------------
+	shared_ptr<const ofPixels> AssetLoader::getPixels(const AssetPath & path)
+	{
+		std::unique_lock<std::mutex> lock(this->mutex);
+		const auto it = this->cache.find(path.path);
+		if (it == this->cache.end())
+		{
+			return nullptr;
+		}
+		it->second.lastUsed = ++this->useCounter;
+		return it->second.pixels;
+	}
+
+	//--------------------------------------------------------------
+	void AssetLoader::setCacheSize(size_t numBytes)
+	{
+		std::unique_lock<std::mutex> lock(this->mutex);
+		this->cacheSize = numBytes;
+		this->trimCache();
+	}
+
+	//--------------------------------------------------------------
+	void AssetLoader::clearCache()
+	{
+		std::unique_lock<std::mutex> lock(this->mutex);
+		this->cache.clear();
+		this->cacheBytes = 0;
+	}
+
+	//--------------------------------------------------------------
+	void AssetLoader::threadedFunction()
+	{
+		AssetPath path;
+		while (this->requests.receive(path))
+		{
+			Asset asset;
+			asset.path = path;
+
+			const auto filePath = ofToDataPath(path.path, true);
+			const auto modified = GetModifiedTime(filePath);
+
+			// Reuse the cached pixels if the file has not changed since they were decoded.
+			{
+				std::unique_lock<std::mutex> lock(this->mutex);
+				const auto it = this->cache.find(path.path);
+				if (it != this->cache.end() && modified >= 0 && it->second.modified == modified)
+				{
+					it->second.lastUsed = ++this->useCounter;
+					asset.pixels = it->second.pixels;
+				}
+			}
+
+			if (!asset.pixels && modified >= 0)
+			{
+				auto pixels = make_shared<ofPixels>();
+				if (ofLoadImage(*pixels, filePath))
+				{
+					asset.pixels = pixels;
+
+					std::unique_lock<std::mutex> lock(this->mutex);
+					auto & entry = this->cache[path.path];
+					this->cacheBytes -= entry.pixels ? entry.numBytes : 0;
+					entry.pixels = pixels;
+					entry.modified = modified;
+					entry.lastUsed = ++this->useCounter;
+					entry.numBytes = pixels->getTotalBytes();
+					this->cacheBytes += entry.numBytes;
+					this->trimCache();
+				}
+			}
+
+			if (!asset.pixels)
+			{
+				ofLogError(__FUNCTION__) << "Could not load asset " << filePath;
+			}
+
+			this->results.send(asset);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void AssetLoader::trimCache()
+	{
+		// Assets handed out keep their pixels alive, this only drops the cache's reference.
+		while (this->cacheBytes > this->cacheSize && !this->cache.empty())
+		{
+			auto oldest = this->cache.begin();
+			for (auto it = this->cache.begin(); it != this->cache.end(); ++it)
+			{
+				if (it->second.lastUsed < oldest->second.lastUsed)
+				{
+					oldest = it;
+				}
+			}
+			this->cacheBytes -= oldest->second.numBytes;
+			this->cache.erase(oldest);
+		}
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "ofConstants.h"
+
+namespace ofxPreset
+{
+	// Path to a file on disk, used as ofParameter<AssetPath> to tell assets apart from plain strings.
+	// Serialized as the path itself, so presets can switch between the two types.
+	struct AssetPath
+	{
+		inline AssetPath();
+		inline AssetPath(const string & path);
+		inline AssetPath(const char * path);
+
+		inline bool empty() const;
+
+		inline bool operator==(const AssetPath & other) const;
+		inline bool operator!=(const AssetPath & other) const;
+
+		string path;
+	};
+
+	inline ostream & operator<<(ostream & os, const AssetPath & assetPath);
+	inline istream & operator>>(istream & is, AssetPath & assetPath);
+}
+
+#include "AssetPath.inl"
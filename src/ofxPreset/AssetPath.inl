@@ -0,0 +1,49 @@
+#include "AssetPath.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	AssetPath::AssetPath()
+	{}
+
+	//--------------------------------------------------------------
+	AssetPath::AssetPath(const string & path)
+		: path(path)
+	{}
+
+	//--------------------------------------------------------------
+	AssetPath::AssetPath(const char * path)
+		: path(path)
+	{}
+
+	//--------------------------------------------------------------
+	bool AssetPath::empty() const
+	{
+		return this->path.empty();
+	}
+
+	//--------------------------------------------------------------
+	bool AssetPath::operator==(const AssetPath & other) const
+	{
+		return this->path == other.path;
+	}
+
+	//--------------------------------------------------------------
+	bool AssetPath::operator!=(const AssetPath & other) const
+	{
+		return this->path != other.path;
+	}
+
+	//--------------------------------------------------------------
+	ostream & operator<<(ostream & os, const AssetPath & assetPath)
+	{
+		return os << assetPath.path;
+	}
+
+	//--------------------------------------------------------------
+	istream & operator>>(istream & is, AssetPath & assetPath)
+	{
+		// Read the whole line, paths can contain spaces.
+		return std::getline(is, assetPath.path);
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ofParameter.h"
+
+#include "Store.h"
+
+namespace ofxPreset
+{
+	// Named snapshots of a Store, kept back to back in a single array.
+	// Saved as a small binary file, tagged with the schema hash of the group so mismatched layouts are rejected.
+	class Bank
+	{
+	public:
+		static const uint32_t kMagic = 0x4b42464f; // "OFBK"
+
+		inline Bank();
+
+		// Takes the layout of the store, and removes all presets.
+		inline void setup(const Store & store);
+		inline void clear();
+
+		inline size_t size() const;
+		inline bool empty() const;
+
+		// Number of floats in each preset.
+		inline size_t getStride() const;
+		inline uint64_t getSchemaHash() const;
+
+		// Replaces the values if a preset with the same name exists, returns its index or -1 if the snapshot does not fit.
+		inline int add(const string & name, const Store::Snapshot & snapshot);
+		inline int add(const string & name, const float * values);
+		inline void remove(size_t index);
+
+		inline const string & getName(size_t index) const;
+		inline const float * getValues(size_t index) const;
+		inline int indexOf(const string & name) const;
+
+		inline void get(size_t index, Store::Snapshot & snapshot) const;
+
+		// All presets, getStride() floats each.
+		inline const float * data() const;
+
+		inline bool save(const string & filePath) const;
+		inline bool load(const string & filePath);
+
+	protected:
+		size_t stride;
+		uint64_t schemaHash;
+
+		vector<string> names;
+		vector<float> values;
+	};
+}
+
+#include "Bank.inl"
@@ -0,0 +1,216 @@
+#include "Bank.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	Bank::Bank()
+		: stride(0)
+		, schemaHash(0)
+	{}
+
+	//--------------------------------------------------------------
+	void Bank::setup(const Store & store)
+	{
+		this->clear();
+
+		this->stride = store.size();
+		this->schemaHash = store.getSchemaHash();
+	}
+
+	//--------------------------------------------------------------
+	void Bank::clear()
+	{
+		this->names.clear();
+		this->values.clear();
+	}
+
+	//--------------------------------------------------------------
+	size_t Bank::size() const
+	{
+		return this->names.size();
+	}
+
+	//--------------------------------------------------------------
+	bool Bank::empty() const
+	{
+		return this->names.empty();
+	}
+
+	//--------------------------------------------------------------
+	size_t Bank::getStride() const
+	{
+		return this->stride;
+	}
+
+	//--------------------------------------------------------------
+	uint64_t Bank::getSchemaHash() const
+	{
+		return this->schemaHash;
+	}
+
+	//--------------------------------------------------------------
+	int Bank::add(const string & name, const Store::Snapshot & snapshot)
+	{
+		if (snapshot.size() != this->stride)
+		{
+			ofLogWarning(__FUNCTION__) << "Snapshot does not match the bank!";
+			return -1;
+		}
+		return this->add(name, snapshot.data());
+	}
+
+	//--------------------------------------------------------------
+	int Bank::add(const string & name, const float * values)
+	{
+		const auto existing = this->indexOf(name);
+		if (existing >= 0)
+		{
+			std::copy(values, values + this->stride, this->values.begin() + existing * this->stride);
+			return existing;
+		}
+
+		this->names.push_back(name);
+		this->values.insert(this->values.end(), values, values + this->stride);
+		return static_cast<int>(this->names.size()) - 1;
+	}
+
+	//--------------------------------------------------------------
+	void Bank::remove(size_t index)
+	{
+		if (index >= this->names.size())
+		{
+			ofLogWarning(__FUNCTION__) << "Index " << index << " out of range!";
+			return;
+		}
+
+		this->names.erase(this->names.begin() + index);
+		this->values.erase(this->values.begin() + index * this->stride, this->values.begin() + (index + 1) * this->stride);
+	}
+
+	//--------------------------------------------------------------
+	const string & Bank::getName(size_t index) const
+	{
+		return this->names[index];
+	}
+
+	//--------------------------------------------------------------
+	const float * Bank::getValues(size_t index) const
+	{
+		return this->values.data() + index * this->stride;
+	}
+
+	//--------------------------------------------------------------
+	int Bank::indexOf(const string & name) const
+	{
+		const auto it = std::find(this->names.begin(), this->names.end(), name);
+		return (it == this->names.end()) ? -1 : static_cast<int>(it - this->names.begin());
+	}
+
+	//--------------------------------------------------------------
+	void Bank::get(size_t index, Store::Snapshot & snapshot) const
+	{
+		const auto values = this->getValues(index);
+		snapshot.assign(values, values + this->stride);
+	}
+
+	//--------------------------------------------------------------
+	const float * Bank::data() const
+	{
+		return this->values.data();
+	}
+
+	//--------------------------------------------------------------
+	bool Bank::save(const string & filePath) const
+	{
+		auto file = fopen(ofToDataPath(filePath, true).c_str(), "wb");
+		if (!file)
+		{
+			ofLogError(__FUNCTION__) << "Could not open " << filePath << " for writing!";
+			return false;
+		}
+
+		const auto magic = kMagic;
+		const auto stride = static_cast<uint32_t>(this->stride);
+		const auto count = static_cast<uint32_t>(this->names.size());
+		fwrite(&magic, sizeof(magic), 1, file);
+		fwrite(&this->schemaHash, sizeof(this->schemaHash), 1, file);
+		fwrite(&stride, sizeof(stride), 1, file);
+		fwrite(&count, sizeof(count), 1, file);
+		for (const auto & name : this->names)
+		{
+			const auto length = static_cast<uint16_t>(std::min<size_t>(name.size(), UINT16_MAX));
+			fwrite(&length, sizeof(length), 1, file);
+			fwrite(name.data(), 1, length, file);
+		}
+		fwrite(this->values.data(), sizeof(float), this->values.size(), file);
+
+		const auto success = !ferror(file);
+		fclose(file);
+		return success;
+	}
+
+	//--------------------------------------------------------------
+	bool Bank::load(const string & filePath)
+	{
+		auto file = fopen(ofToDataPath(filePath, true).c_str(), "rb");
+		if (!file)
+		{
+			ofLogWarning(__FUNCTION__) << "Could not open " << filePath << "!";
+			return false;
+		}
+
+		uint32_t magic = 0;
+		uint64_t schemaHash = 0;
+		uint32_t stride = 0;
+		uint32_t count = 0;
+		auto success = fread(&magic, sizeof(magic), 1, file) == 1 && fread(&schemaHash, sizeof(schemaHash), 1, file) == 1
+			&& fread(&stride, sizeof(stride), 1, file) == 1 && fread(&count, sizeof(count), 1, file) == 1 && magic == kMagic;
+		if (!success)
+		{
+			ofLogError(__FUNCTION__) << "File " << filePath << " is not a bank!";
+			fclose(file);
+			return false;
+		}
+		if (schemaHash != this->schemaHash || stride != this->stride)
+		{
+			ofLogError(__FUNCTION__) << "Bank " << filePath << " was saved from a different group layout!";
+			fclose(file);
+			return false;
+		}
+
+		// Each preset takes at least its name length and values, check the count before allocating.
+		const auto headerSize = ftell(file);
+		fseek(file, 0, SEEK_END);
+		const auto fileSize = ftell(file);
+		fseek(file, headerSize, SEEK_SET);
+		const auto minSize = static_cast<uint64_t>(count) * (sizeof(uint16_t) + static_cast<uint64_t>(stride) * sizeof(float));
+		if (headerSize < 0 || fileSize < headerSize || minSize > static_cast<uint64_t>(fileSize - headerSize))
+		{
+			ofLogError(__FUNCTION__) << "Bank " << filePath << " is truncated!";
+			fclose(file);
+			return false;
+		}
+
+		vector<string> names(count);
+		for (auto & name : names)
+		{
+			uint16_t length = 0;
+			success = success && fread(&length, sizeof(length), 1, file) == 1;
+			name.resize(length);
+			success = success && (!length || fread(&name[0], 1, length, file) == length);
+		}
+		vector<float> values(static_cast<size_t>(count) * stride);
+		success = success && fread(values.data(), sizeof(float), values.size(), file) == values.size();
+		fclose(file);
+
+		if (!success)
+		{
+			ofLogError(__FUNCTION__) << "Bank " << filePath << " is truncated!";
+			return false;
+		}
+
+		this->names = std::move(names);
+		this->values = std::move(values);
+		return true;
+	}
+}
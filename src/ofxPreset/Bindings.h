@@ -0,0 +1,111 @@
+#pragma once
+
+#include "ofParameter.h"
+
+#include "AssetPath.h"
+
+namespace ofxPreset
+{
+	// A leaf parameter of a group, addressed by its index in the flattened tree.
+	class Binding
+	{
+	public:
+		enum class Type : uint8_t
+		{
+			Unknown = 0,
+			Bool,
+			Int,
+			Float,
+			Vec2,
+			Vec3,
+			Vec4,
+			OfVec2,
+			OfVec3,
+			OfVec4,
+			FloatColor,
+			String,
+			AssetPath
+		};
+
+		static const size_t kMaxComponents = 4;
+
+		static inline Type GetType(const ofAbstractParameter & parameter);
+		static inline size_t GetNumComponents(Type type);
+		static inline const void * GetIdentity(const ofAbstractParameter & parameter, Type type);
+
+		// Returns false and leaves the parameter alone if the value is unchanged.
+		// Parameters of unknown types always notify, as ofAbstractParameter cannot be silenced.
+		static inline bool FromString(ofAbstractParameter & parameter, Type type, const string & valueString, bool notify = true);
+		static inline void Notify(ofAbstractParameter & parameter, Type type);
+
+		// Returns false and leaves the parameter alone if the value is unchanged.
+		static inline bool SetComponents(ofAbstractParameter & parameter, Type type, const float * values, bool notify = true);
+
+		// Parses a value written by ofToString(), e.g. "0.5, 1, 0.25", without going through a stream and whatever the locale.
+		// Returns false if a component is not a plain number followed by a separator or the end of the string.
+		static inline bool ParseComponents(const string & valueString, float * values, size_t count);
+		// Formats components the way ofToString() formats the value they make up.
+		static inline string ToString(Type type, const float * values);
+
+		inline Binding(const shared_ptr<ofAbstractParameter> & parameter, const string & path);
+
+		inline size_t getNumComponents() const;
+		inline bool isNumeric() const;
+
+		// Numeric values are exchanged as float components (ints are exact up to 2^24).
+		inline size_t getComponents(float * values) const;
+		inline bool setComponents(const float * values, bool notify = true) const;
+		// Ints left at their default limits have no range, and report infinite limits like unranged floats.
+		inline void getRange(float * minValues, float * maxValues) const;
+
+		// Fires the change events of the parameter with its current value.
+		inline void notify() const;
+
+		shared_ptr<ofAbstractParameter> parameter;
+		string path;
+		Type type;
+		const void * identity;
+	};
+
+	// Flattened, depth-first index of all leaf parameters in a group.
+	class Bindings
+	{
+	public:
+		static const uint64_t kHashSeed = 14695981039346656037ULL;
+
+		static inline uint64_t Hash(const void * data, size_t size, uint64_t seed = kHashSeed);
+		static inline uint64_t Hash(const string & str, uint64_t seed = kHashSeed);
+
+		inline Bindings();
+		inline Bindings(ofParameterGroup & group);
+
+		inline void setup(ofParameterGroup & group);
+		inline void clear();
+
+		inline size_t size() const;
+		inline bool empty() const;
+
+		inline const Binding & operator[](size_t index) const;
+		inline vector<Binding>::const_iterator begin() const;
+		inline vector<Binding>::const_iterator end() const;
+
+		inline int indexOf(const ofAbstractParameter & parameter) const;
+		inline int indexOf(const string & path) const;
+
+		inline ofParameterGroup & getGroup();
+
+		// Hash of the paths and types of all bindings, used to detect mismatched layouts.
+		inline uint64_t getSchemaHash() const;
+
+	protected:
+		inline void addGroup(ofParameterGroup & group, const string & prefix);
+
+		ofParameterGroup group;
+		vector<Binding> bindings;
+		unordered_map<const void *, size_t> indexByIdentity;
+		unordered_map<string, size_t> indexByPath;
+		uint64_t schemaHash;
+	};
+}
+
+#include "Bindings.inl"
@@ -0,0 +1,532 @@
+#include "Bindings.h"
+
+#include <clocale>
+#include <cstdlib>
+#ifdef TARGET_OSX
+#include <xlocale.h>
+#endif
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	Binding::Type Binding::GetType(const ofAbstractParameter & parameter)
+	{
+		const auto & info = typeid(parameter);
+		if (info == typeid(ofParameter<float>)) return Type::Float;
+		if (info == typeid(ofParameter<int>)) return Type::Int;
+		if (info == typeid(ofParameter<bool>)) return Type::Bool;
+		if (info == typeid(ofParameter<glm::vec2>)) return Type::Vec2;
+		if (info == typeid(ofParameter<glm::vec3>)) return Type::Vec3;
+		if (info == typeid(ofParameter<glm::vec4>)) return Type::Vec4;
+		if (info == typeid(ofParameter<ofVec2f>)) return Type::OfVec2;
+		if (info == typeid(ofParameter<ofVec3f>)) return Type::OfVec3;
+		if (info == typeid(ofParameter<ofVec4f>)) return Type::OfVec4;
+		if (info == typeid(ofParameter<ofFloatColor>)) return Type::FloatColor;
+		if (info == typeid(ofParameter<string>)) return Type::String;
+		if (info == typeid(ofParameter<AssetPath>)) return Type::AssetPath;
+		return Type::Unknown;
+	}
+
+	//--------------------------------------------------------------
+	size_t Binding::GetNumComponents(Type type)
+	{
+		switch (type)
+		{
+		case Type::Bool:
+		case Type::Int:
+		case Type::Float:
+			return 1;
+		case Type::Vec2:
+		case Type::OfVec2:
+			return 2;
+		case Type::Vec3:
+		case Type::OfVec3:
+			return 3;
+		case Type::Vec4:
+		case Type::OfVec4:
+		case Type::FloatColor:
+			return 4;
+		default:
+			return 0;
+		}
+	}
+
+	//--------------------------------------------------------------
+	const void * Binding::GetIdentity(const ofAbstractParameter & parameter, Type type)
+	{
+		// The address of the value is shared by all references to the same parameter.
+		switch (type)
+		{
+		case Type::Bool: return &parameter.cast<bool>().get();
+		case Type::Int: return &parameter.cast<int>().get();
+		case Type::Float: return &parameter.cast<float>().get();
+		case Type::Vec2: return &parameter.cast<glm::vec2>().get();
+		case Type::Vec3: return &parameter.cast<glm::vec3>().get();
+		case Type::Vec4: return &parameter.cast<glm::vec4>().get();
+		case Type::OfVec2: return &parameter.cast<ofVec2f>().get();
+		case Type::OfVec3: return &parameter.cast<ofVec3f>().get();
+		case Type::OfVec4: return &parameter.cast<ofVec4f>().get();
+		case Type::FloatColor: return &parameter.cast<ofFloatColor>().get();
+		case Type::String: return &parameter.cast<string>().get();
+		case Type::AssetPath: return &parameter.cast<AssetPath>().get();
+		default: return nullptr;
+		}
+	}
+
+	//--------------------------------------------------------------
+	template<typename ValueType>
+	static inline bool SetBindingValue(ofParameter<ValueType> & parameter, const ValueType & value, bool notify)
+	{
+		if (parameter.get() == value)
+		{
+			return false;
+		}
+
+		if (notify)
+		{
+			parameter.set(value);
+		}
+		else
+		{
+			parameter.setWithoutEventNotifications(value);
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	template<typename ValueType>
+	static inline void NotifyBindingValue(ofAbstractParameter & parameter)
+	{
+		auto & typedParameter = parameter.cast<ValueType>();
+		typedParameter.set(typedParameter.get());
+	}
+
+	//--------------------------------------------------------------
+	template<typename ValueType>
+	static inline void GetBindingVector(const ofAbstractParameter & parameter, float * values, size_t count)
+	{
+		auto value = parameter.cast<ValueType>().get();
+		for (size_t i = 0; i < count; ++i)
+		{
+			values[i] = value[i];
+		}
+	}
+
+	//--------------------------------------------------------------
+	template<typename ValueType>
+	static inline bool SetBindingVector(ofAbstractParameter & parameter, const float * values, size_t count, bool notify)
+	{
+		auto & typedParameter = parameter.cast<ValueType>();
+		auto value = typedParameter.get();
+		for (size_t i = 0; i < count; ++i)
+		{
+			value[i] = values[i];
+		}
+		return SetBindingValue(typedParameter, value, notify);
+	}
+
+	//--------------------------------------------------------------
+	template<typename ValueType>
+	static inline void GetBindingVectorRange(const ofAbstractParameter & parameter, float * minValues, float * maxValues, size_t count)
+	{
+		const auto & typedParameter = parameter.cast<ValueType>();
+		auto minValue = typedParameter.getMin();
+		auto maxValue = typedParameter.getMax();
+		for (size_t i = 0; i < count; ++i)
+		{
+			minValues[i] = minValue[i];
+			maxValues[i] = maxValue[i];
+		}
+	}
+
+	//--------------------------------------------------------------
+	template<typename ValueType>
+	static inline string GetBindingVectorString(const float * values, size_t count)
+	{
+		ValueType value;
+		for (size_t i = 0; i < count; ++i)
+		{
+			value[i] = values[i];
+		}
+		return ofToString(value);
+	}
+
+	//--------------------------------------------------------------
+	bool Binding::FromString(ofAbstractParameter & parameter, Type type, const string & valueString, bool notify)
+	{
+		switch (type)
+		{
+		case Type::Bool: return SetBindingValue(parameter.cast<bool>(), ofFromString<bool>(valueString), notify);
+		case Type::Int: return SetBindingValue(parameter.cast<int>(), ofFromString<int>(valueString), notify);
+		case Type::Float: return SetBindingValue(parameter.cast<float>(), ofFromString<float>(valueString), notify);
+		case Type::Vec2: return SetBindingValue(parameter.cast<glm::vec2>(), ofFromString<glm::vec2>(valueString), notify);
+		case Type::Vec3: return SetBindingValue(parameter.cast<glm::vec3>(), ofFromString<glm::vec3>(valueString), notify);
+		case Type::Vec4: return SetBindingValue(parameter.cast<glm::vec4>(), ofFromString<glm::vec4>(valueString), notify);
+		case Type::OfVec2: return SetBindingValue(parameter.cast<ofVec2f>(), ofFromString<ofVec2f>(valueString), notify);
+		case Type::OfVec3: return SetBindingValue(parameter.cast<ofVec3f>(), ofFromString<ofVec3f>(valueString), notify);
+		case Type::OfVec4: return SetBindingValue(parameter.cast<ofVec4f>(), ofFromString<ofVec4f>(valueString), notify);
+		case Type::FloatColor: return SetBindingValue(parameter.cast<ofFloatColor>(), ofFromString<ofFloatColor>(valueString), notify);
+		case Type::String: return SetBindingValue(parameter.cast<string>(), valueString, notify);
+		case Type::AssetPath: return SetBindingValue(parameter.cast<AssetPath>(), AssetPath(valueString), notify);
+		default:
+			if (parameter.toString() == valueString)
+			{
+				return false;
+			}
+			parameter.fromString(valueString);
+			return true;
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Binding::Notify(ofAbstractParameter & parameter, Type type)
+	{
+		switch (type)
+		{
+		case Type::Bool: NotifyBindingValue<bool>(parameter); break;
+		case Type::Int: NotifyBindingValue<int>(parameter); break;
+		case Type::Float: NotifyBindingValue<float>(parameter); break;
+		case Type::Vec2: NotifyBindingValue<glm::vec2>(parameter); break;
+		case Type::Vec3: NotifyBindingValue<glm::vec3>(parameter); break;
+		case Type::Vec4: NotifyBindingValue<glm::vec4>(parameter); break;
+		case Type::OfVec2: NotifyBindingValue<ofVec2f>(parameter); break;
+		case Type::OfVec3: NotifyBindingValue<ofVec3f>(parameter); break;
+		case Type::OfVec4: NotifyBindingValue<ofVec4f>(parameter); break;
+		case Type::FloatColor: NotifyBindingValue<ofFloatColor>(parameter); break;
+		case Type::String: NotifyBindingValue<string>(parameter); break;
+		case Type::AssetPath: NotifyBindingValue<AssetPath>(parameter); break;
+		default: parameter.fromString(parameter.toString()); break;
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool Binding::SetComponents(ofAbstractParameter & parameter, Type type, const float * values, bool notify)
+	{
+		const auto count = GetNumComponents(type);
+		switch (type)
+		{
+		case Type::Bool: return SetBindingValue(parameter.cast<bool>(), values[0] >= 0.5f, notify);
+		case Type::Int: return SetBindingValue(parameter.cast<int>(), static_cast<int>(std::round(values[0])), notify);
+		case Type::Float: return SetBindingValue(parameter.cast<float>(), values[0], notify);
+		case Type::Vec2: return SetBindingVector<glm::vec2>(parameter, values, count, notify);
+		case Type::Vec3: return SetBindingVector<glm::vec3>(parameter, values, count, notify);
+		case Type::Vec4: return SetBindingVector<glm::vec4>(parameter, values, count, notify);
+		case Type::OfVec2: return SetBindingVector<ofVec2f>(parameter, values, count, notify);
+		case Type::OfVec3: return SetBindingVector<ofVec3f>(parameter, values, count, notify);
+		case Type::OfVec4: return SetBindingVector<ofVec4f>(parameter, values, count, notify);
+		case Type::FloatColor: return SetBindingVector<ofFloatColor>(parameter, values, count, notify);
+		default: return false;
+		}
+	}
+
+	//--------------------------------------------------------------
+	static inline float ParseClassicFloat(const char * str, char ** end)
+	{
+		// ofToString() always writes a '.', whatever the global locale says.
+#ifdef TARGET_WIN32
+		static const auto locale = _create_locale(LC_NUMERIC, "C");
+		return _strtof_l(str, end, locale);
+#else
+		static const auto locale = newlocale(LC_NUMERIC_MASK, "C", static_cast<locale_t>(0));
+		return strtof_l(str, end, locale);
+#endif
+	}
+
+	//--------------------------------------------------------------
+	bool Binding::ParseComponents(const string & valueString, float * values, size_t count)
+	{
+		auto str = valueString.c_str();
+		for (size_t i = 0; i < count; ++i)
+		{
+			// Skip the ", " separators.
+			while (*str == ',' || *str == ' ')
+			{
+				++str;
+			}
+
+			char * end;
+			values[i] = ParseClassicFloat(str, &end);
+			if (end == str)
+			{
+				return false;
+			}
+
+			// Anything else glued to the number is not ours to parse, leave it to fromString().
+			if (*end != ',' && *end != ' ' && *end != '\0')
+			{
+				return false;
+			}
+			str = end;
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	string Binding::ToString(Type type, const float * values)
+	{
+		const auto count = GetNumComponents(type);
+		switch (type)
+		{
+		case Type::Bool: return ofToString(values[0] >= 0.5f);
+		case Type::Int: return ofToString(static_cast<int>(std::round(values[0])));
+		case Type::Float: return ofToString(values[0]);
+		case Type::Vec2: return GetBindingVectorString<glm::vec2>(values, count);
+		case Type::Vec3: return GetBindingVectorString<glm::vec3>(values, count);
+		case Type::Vec4: return GetBindingVectorString<glm::vec4>(values, count);
+		case Type::OfVec2: return GetBindingVectorString<ofVec2f>(values, count);
+		case Type::OfVec3: return GetBindingVectorString<ofVec3f>(values, count);
+		case Type::OfVec4: return GetBindingVectorString<ofVec4f>(values, count);
+		case Type::FloatColor: return GetBindingVectorString<ofFloatColor>(values, count);
+		default: return string();
+		}
+	}
+
+	//--------------------------------------------------------------
+	Binding::Binding(const shared_ptr<ofAbstractParameter> & parameter, const string & path)
+		: parameter(parameter)
+		, path(path)
+		, type(GetType(*parameter))
+		, identity(GetIdentity(*parameter, type))
+	{}
+
+	//--------------------------------------------------------------
+	size_t Binding::getNumComponents() const
+	{
+		return GetNumComponents(this->type);
+	}
+
+	//--------------------------------------------------------------
+	bool Binding::isNumeric() const
+	{
+		return this->getNumComponents() > 0;
+	}
+
+	//--------------------------------------------------------------
+	size_t Binding::getComponents(float * values) const
+	{
+		const auto count = this->getNumComponents();
+		switch (this->type)
+		{
+		case Type::Bool:
+			values[0] = this->parameter->cast<bool>().get() ? 1.0f : 0.0f;
+			break;
+		case Type::Int:
+			values[0] = this->parameter->cast<int>().get();
+			break;
+		case Type::Float:
+			values[0] = this->parameter->cast<float>().get();
+			break;
+		case Type::Vec2: GetBindingVector<glm::vec2>(*this->parameter, values, count); break;
+		case Type::Vec3: GetBindingVector<glm::vec3>(*this->parameter, values, count); break;
+		case Type::Vec4: GetBindingVector<glm::vec4>(*this->parameter, values, count); break;
+		case Type::OfVec2: GetBindingVector<ofVec2f>(*this->parameter, values, count); break;
+		case Type::OfVec3: GetBindingVector<ofVec3f>(*this->parameter, values, count); break;
+		case Type::OfVec4: GetBindingVector<ofVec4f>(*this->parameter, values, count); break;
+		case Type::FloatColor: GetBindingVector<ofFloatColor>(*this->parameter, values, count); break;
+		default: break;
+		}
+		return count;
+	}
+
+	//--------------------------------------------------------------
+	bool Binding::setComponents(const float * values, bool notify) const
+	{
+		return SetComponents(*this->parameter, this->type, values, notify);
+	}
+
+	//--------------------------------------------------------------
+	void Binding::getRange(float * minValues, float * maxValues) const
+	{
+		const auto count = this->getNumComponents();
+		switch (this->type)
+		{
+		case Type::Bool:
+			minValues[0] = 0.0f;
+			maxValues[0] = 1.0f;
+			break;
+		case Type::Int:
+		{
+			const auto minValue = this->parameter->cast<int>().getMin();
+			const auto maxValue = this->parameter->cast<int>().getMax();
+			minValues[0] = (minValue == std::numeric_limits<int>::lowest()) ? -std::numeric_limits<float>::infinity() : minValue;
+			maxValues[0] = (maxValue == std::numeric_limits<int>::max()) ? std::numeric_limits<float>::infinity() : maxValue;
+			break;
+		}
+		case Type::Float:
+			minValues[0] = this->parameter->cast<float>().getMin();
+			maxValues[0] = this->parameter->cast<float>().getMax();
+			break;
+		case Type::Vec2: GetBindingVectorRange<glm::vec2>(*this->parameter, minValues, maxValues, count); break;
+		case Type::Vec3: GetBindingVectorRange<glm::vec3>(*this->parameter, minValues, maxValues, count); break;
+		case Type::Vec4: GetBindingVectorRange<glm::vec4>(*this->parameter, minValues, maxValues, count); break;
+		case Type::OfVec2: GetBindingVectorRange<ofVec2f>(*this->parameter, minValues, maxValues, count); break;
+		case Type::OfVec3: GetBindingVectorRange<ofVec3f>(*this->parameter, minValues, maxValues, count); break;
+		case Type::OfVec4: GetBindingVectorRange<ofVec4f>(*this->parameter, minValues, maxValues, count); break;
+		case Type::FloatColor: GetBindingVectorRange<ofFloatColor>(*this->parameter, minValues, maxValues, count); break;
+		default: break;
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Binding::notify() const
+	{
+		Notify(*this->parameter, this->type);
+	}
+
+	//--------------------------------------------------------------
+	uint64_t Bindings::Hash(const void * data, size_t size, uint64_t seed)
+	{
+		// FNV-1a
+		auto bytes = static_cast<const uint8_t *>(data);
+		auto hash = seed;
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+
+	//--------------------------------------------------------------
+	uint64_t Bindings::Hash(const string & str, uint64_t seed)
+	{
+		return Hash(str.data(), str.size(), seed);
+	}
+
+	//--------------------------------------------------------------
+	Bindings::Bindings()
+		: schemaHash(kHashSeed)
+	{}
+
+	//--------------------------------------------------------------
+	Bindings::Bindings(ofParameterGroup & group)
+		: Bindings()
+	{
+		this->setup(group);
+	}
+
+	//--------------------------------------------------------------
+	void Bindings::setup(ofParameterGroup & group)
+	{
+		this->clear();
+
+		this->group = group;
+		this->addGroup(group, "");
+	}
+
+	//--------------------------------------------------------------
+	void Bindings::clear()
+	{
+		this->group = ofParameterGroup();
+		this->bindings.clear();
+		this->indexByIdentity.clear();
+		this->indexByPath.clear();
+		this->schemaHash = kHashSeed;
+	}
+
+	//--------------------------------------------------------------
+	size_t Bindings::size() const
+	{
+		return this->bindings.size();
+	}
+
+	//--------------------------------------------------------------
+	bool Bindings::empty() const
+	{
+		return this->bindings.empty();
+	}
+
+	//--------------------------------------------------------------
+	const Binding & Bindings::operator[](size_t index) const
+	{
+		return this->bindings[index];
+	}
+
+	//--------------------------------------------------------------
+	vector<Binding>::const_iterator Bindings::begin() const
+	{
+		return this->bindings.begin();
+	}
+
+	//--------------------------------------------------------------
+	vector<Binding>::const_iterator Bindings::end() const
+	{
+		return this->bindings.end();
+	}
+
+	//--------------------------------------------------------------
+	int Bindings::indexOf(const ofAbstractParameter & parameter) const
+	{
+		const auto identity = Binding::GetIdentity(parameter, Binding::GetType(parameter));
+		if (identity)
+		{
+			const auto it = this->indexByIdentity.find(identity);
+			return (it == this->indexByIdentity.end()) ? -1 : static_cast<int>(it->second);
+		}
+
+		// Unknown types have no identity, fall back to a linear search.
+		for (size_t i = 0; i < this->bindings.size(); ++i)
+		{
+			if (this->bindings[i].parameter->isReferenceTo(parameter))
+			{
+				return static_cast<int>(i);
+			}
+		}
+		return -1;
+	}
+
+	//--------------------------------------------------------------
+	int Bindings::indexOf(const string & path) const
+	{
+		const auto it = this->indexByPath.find(path);
+		return (it == this->indexByPath.end()) ? -1 : static_cast<int>(it->second);
+	}
+
+	//--------------------------------------------------------------
+	ofParameterGroup & Bindings::getGroup()
+	{
+		return this->group;
+	}
+
+	//--------------------------------------------------------------
+	uint64_t Bindings::getSchemaHash() const
+	{
+		return this->schemaHash;
+	}
+
+	//--------------------------------------------------------------
+	void Bindings::addGroup(ofParameterGroup & group, const string & prefix)
+	{
+		const auto path = group.getName().empty() ? prefix : prefix + "/" + group.getName();
+		for (const auto & parameter : group)
+		{
+			if (!parameter)
+			{
+				continue;
+			}
+
+			// Group.
+			auto parameterGroup = dynamic_pointer_cast<ofParameterGroup>(parameter);
+			if (parameterGroup)
+			{
+				// Recurse through contents.
+				this->addGroup(*parameterGroup, path);
+				continue;
+			}
+
+			// Parameter.
+			const auto index = this->bindings.size();
+			this->bindings.emplace_back(parameter, path + "/" + parameter->getName());
+
+			const auto & binding = this->bindings.back();
+			if (binding.identity)
+			{
+				this->indexByIdentity.emplace(binding.identity, index);
+			}
+			this->indexByPath.emplace(binding.path, index);
+
+			this->schemaHash = Hash(binding.path, this->schemaHash);
+			this->schemaHash = Hash(&binding.type, sizeof(binding.type), this->schemaHash);
+		}
+	}
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <queue>
+
+#include "ofEvents.h"
+#include "ofParameter.h"
+
+#include "Bindings.h"
+
+namespace ofxPreset
+{
+	// Parameters computed from other parameters of a group, e.g. "{/App/Mesh/Size Min} * 4".
+	// Expressions are compiled once and sorted by dependency. When inputs change, only the expressions
+	// downstream of them are evaluated on the next update(), each one once, in dependency order.
+	class Expressions
+	{
+	public:
+		inline Expressions();
+
+		inline void setup(ofParameterGroup & group);
+		inline void clear();
+
+		// References are parameter paths in braces, vector and color parameters are evaluated per component.
+		// Supports + - * / %, parentheses, pi, and sin cos tan abs floor ceil fract sqrt exp log min max pow clamp mix.
+		// Returns false if the expression does not compile or creates a cycle, see getError().
+		inline bool set(const string & targetPath, const string & expression);
+		inline bool remove(const string & targetPath);
+
+		inline size_t size() const;
+		inline bool empty() const;
+
+		inline const string & getTarget(size_t index) const;
+		inline const string & getExpression(size_t index) const;
+		inline int indexOf(const string & targetPath) const;
+
+		inline bool isLinked(const ofAbstractParameter & parameter) const;
+		inline const string & getError() const;
+
+		// Evaluates the expressions whose inputs changed, returns how many were evaluated.
+		inline size_t update();
+
+	protected:
+		enum class OpCode : uint8_t
+		{
+			Constant,
+			Load,
+			Add,
+			Subtract,
+			Multiply,
+			Divide,
+			Modulo,
+			Negate,
+			Call
+		};
+
+		enum class Function : uint8_t
+		{
+			Sin,
+			Cos,
+			Tan,
+			Abs,
+			Floor,
+			Ceil,
+			Fract,
+			Sqrt,
+			Exp,
+			Log,
+			Min,
+			Max,
+			Pow,
+			Clamp,
+			Mix
+		};
+
+		struct Op
+		{
+			OpCode code;
+			float value;
+			int binding;
+			Function function;
+			size_t numArguments;
+		};
+
+		struct Expression
+		{
+			string target;
+			string source;
+			int binding;
+			vector<Op> ops;
+			vector<int> inputs;
+			size_t rank;
+			bool dirty;
+		};
+
+		// Recursive descent compiler to a stack program.
+		struct Compiler
+		{
+			inline Compiler(const Bindings & bindings, const string & source);
+
+			const Bindings & bindings;
+			const char * str;
+			const char * end;
+			vector<Op> ops;
+			vector<int> inputs;
+			string error;
+
+			inline bool compileSum();
+			inline bool compileProduct();
+			inline bool compileUnary();
+			inline bool compilePrimary();
+			inline bool compileCall(const string & name);
+			inline void skipWhitespace();
+			inline bool accept(char c);
+		};
+
+		static inline bool GetFunction(const string & name, Function & function, size_t & numArguments);
+		static inline float Call(Function function, const float * arguments);
+
+		inline bool sort();
+		inline void markDirty(size_t index);
+		inline void evaluate(Expression & expression);
+
+		Bindings bindings;
+		ofEventListener listener;
+
+		vector<Expression> expressions;
+		vector<int> expressionByBinding;
+		unordered_map<int, vector<size_t>> dependents;
+
+		std::priority_queue<std::pair<size_t, size_t>, vector<std::pair<size_t, size_t>>, std::greater<std::pair<size_t, size_t>>> queue;
+		vector<float> stack;
+		string error;
+	};
+}
+
+#include "Expressions.inl"
@@ -0,0 +1,677 @@
+#include "Expressions.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	Expressions::Compiler::Compiler(const Bindings & bindings, const string & source)
+		: bindings(bindings)
+		, str(source.c_str())
+		, end(source.c_str() + source.size())
+	{}
+
+	//--------------------------------------------------------------
+	bool Expressions::Compiler::compileSum()
+	{
+		if (!this->compileProduct())
+		{
+			return false;
+		}
+		while (true)
+		{
+			Op op = { OpCode::Add };
+			if (this->accept('+'))
+			{
+				op.code = OpCode::Add;
+			}
+			else if (this->accept('-'))
+			{
+				op.code = OpCode::Subtract;
+			}
+			else
+			{
+				return true;
+			}
+			if (!this->compileProduct())
+			{
+				return false;
+			}
+			this->ops.push_back(op);
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool Expressions::Compiler::compileProduct()
+	{
+		if (!this->compileUnary())
+		{
+			return false;
+		}
+		while (true)
+		{
+			Op op = { OpCode::Multiply };
+			if (this->accept('*'))
+			{
+				op.code = OpCode::Multiply;
+			}
+			else if (this->accept('/'))
+			{
+				op.code = OpCode::Divide;
+			}
+			else if (this->accept('%'))
+			{
+				op.code = OpCode::Modulo;
+			}
+			else
+			{
+				return true;
+			}
+			if (!this->compileUnary())
+			{
+				return false;
+			}
+			this->ops.push_back(op);
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool Expressions::Compiler::compileUnary()
+	{
+		if (this->accept('-'))
+		{
+			if (!this->compileUnary())
+			{
+				return false;
+			}
+			Op op = { OpCode::Negate };
+			this->ops.push_back(op);
+			return true;
+		}
+		if (this->accept('+'))
+		{
+			return this->compileUnary();
+		}
+		return this->compilePrimary();
+	}
+
+	//--------------------------------------------------------------
+	bool Expressions::Compiler::compilePrimary()
+	{
+		this->skipWhitespace();
+		if (this->str == this->end)
+		{
+			this->error = "Unexpected end of expression";
+			return false;
+		}
+
+		// Parenthesis.
+		if (this->accept('('))
+		{
+			if (!this->compileSum())
+			{
+				return false;
+			}
+			if (!this->accept(')'))
+			{
+				this->error = "Missing )";
+				return false;
+			}
+			return true;
+		}
+
+		// Parameter reference.
+		if (this->accept('{'))
+		{
+			const auto begin = this->str;
+			while (this->str != this->end && *this->str != '}')
+			{
+				++this->str;
+			}
+			if (this->str == this->end)
+			{
+				this->error = "Missing }";
+				return false;
+			}
+			const auto path = string(begin, this->str);
+			++this->str;
+
+			const auto binding = this->bindings.indexOf(path);
+			if (binding < 0)
+			{
+				this->error = "Parameter " + path + " not found";
+				return false;
+			}
+			if (!this->bindings[binding].isNumeric())
+			{
+				this->error = "Parameter " + path + " is not numeric";
+				return false;
+			}
+			Op op = { OpCode::Load, 0.0f, binding };
+			this->ops.push_back(op);
+			if (std::find(this->inputs.begin(), this->inputs.end(), binding) == this->inputs.end())
+			{
+				this->inputs.push_back(binding);
+			}
+			return true;
+		}
+
+		// Number.
+		if (isdigit(*this->str) || *this->str == '.')
+		{
+			char * numberEnd = nullptr;
+			const auto value = strtof(this->str, &numberEnd);
+			if (numberEnd == this->str)
+			{
+				this->error = "Invalid number";
+				return false;
+			}
+			this->str = numberEnd;
+			Op op = { OpCode::Constant, value };
+			this->ops.push_back(op);
+			return true;
+		}
+
+		// Constant or function.
+		if (isalpha(*this->str) || *this->str == '_')
+		{
+			const auto begin = this->str;
+			while (this->str != this->end && (isalnum(*this->str) || *this->str == '_'))
+			{
+				++this->str;
+			}
+			const auto name = string(begin, this->str);
+			if (name == "pi")
+			{
+				Op op = { OpCode::Constant, PI };
+				this->ops.push_back(op);
+				return true;
+			}
+			return this->compileCall(name);
+		}
+
+		this->error = string("Unexpected character ") + *this->str;
+		return false;
+	}
+
+	//--------------------------------------------------------------
+	bool Expressions::Compiler::compileCall(const string & name)
+	{
+		Op op = { OpCode::Call };
+		if (!GetFunction(name, op.function, op.numArguments))
+		{
+			this->error = "Unknown function " + name;
+			return false;
+		}
+		if (!this->accept('('))
+		{
+			this->error = "Missing ( after " + name;
+			return false;
+		}
+		for (size_t i = 0; i < op.numArguments; ++i)
+		{
+			if (i > 0 && !this->accept(','))
+			{
+				this->error = name + " takes " + ofToString(op.numArguments) + " arguments";
+				return false;
+			}
+			if (!this->compileSum())
+			{
+				return false;
+			}
+		}
+		if (!this->accept(')'))
+		{
+			this->error = name + " takes " + ofToString(op.numArguments) + " arguments";
+			return false;
+		}
+		this->ops.push_back(op);
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	void Expressions::Compiler::skipWhitespace()
+	{
+		while (this->str != this->end && isspace(*this->str))
+		{
+			++this->str;
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool Expressions::Compiler::accept(char c)
+	{
+		this->skipWhitespace();
+		if (this->str != this->end && *this->str == c)
+		{
+			++this->str;
+			return true;
+		}
+		return false;
+	}
+
+	//--------------------------------------------------------------
+	bool Expressions::GetFunction(const string & name, Function & function, size_t & numArguments)
+	{
+		static const unordered_map<string, std::pair<Function, size_t>> functions =
+		{
+			{ "sin", { Function::Sin, 1 } },
+			{ "cos", { Function::Cos, 1 } },
+			{ "tan", { Function::Tan, 1 } },
+			{ "abs", { Function::Abs, 1 } },
+			{ "floor", { Function::Floor, 1 } },
+			{ "ceil", { Function::Ceil, 1 } },
+			{ "fract", { Function::Fract, 1 } },
+			{ "sqrt", { Function::Sqrt, 1 } },
+			{ "exp", { Function::Exp, 1 } },
+			{ "log", { Function::Log, 1 } },
+			{ "min", { Function::Min, 2 } },
+			{ "max", { Function::Max, 2 } },
+			{ "pow", { Function::Pow, 2 } },
+			{ "clamp", { Function::Clamp, 3 } },
+			{ "mix", { Function::Mix, 3 } }
+		};
+
+		const auto it = functions.find(name);
+		if (it == functions.end())
+		{
+			return false;
+		}
+		function = it->second.first;
+		numArguments = it->second.second;
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	float Expressions::Call(Function function, const float * arguments)
+	{
+		switch (function)
+		{
+		case Function::Sin:
+			return sinf(arguments[0]);
+		case Function::Cos:
+			return cosf(arguments[0]);
+		case Function::Tan:
+			return tanf(arguments[0]);
+		case Function::Abs:
+			return fabsf(arguments[0]);
+		case Function::Floor:
+			return floorf(arguments[0]);
+		case Function::Ceil:
+			return ceilf(arguments[0]);
+		case Function::Fract:
+			return arguments[0] - floorf(arguments[0]);
+		case Function::Sqrt:
+			return sqrtf(arguments[0]);
+		case Function::Exp:
+			return expf(arguments[0]);
+		case Function::Log:
+			return logf(arguments[0]);
+		case Function::Min:
+			return std::min(arguments[0], arguments[1]);
+		case Function::Max:
+			return std::max(arguments[0], arguments[1]);
+		case Function::Pow:
+			return powf(arguments[0], arguments[1]);
+		case Function::Clamp:
+			return std::min(std::max(arguments[0], arguments[1]), arguments[2]);
+		case Function::Mix:
+			return arguments[0] + (arguments[1] - arguments[0]) * arguments[2];
+		}
+		return 0.0f;
+	}
+
+	//--------------------------------------------------------------
+	Expressions::Expressions()
+	{}
+
+	//--------------------------------------------------------------
+	void Expressions::setup(ofParameterGroup & group)
+	{
+		this->clear();
+
+		this->bindings.setup(group);
+		this->expressionByBinding.assign(this->bindings.size(), -1);
+
+		this->listener = this->bindings.getGroup().parameterChangedE().newListener([this](ofAbstractParameter & parameter)
+		{
+			const auto index = this->bindings.indexOf(parameter);
+			if (index < 0)
+			{
+				return;
+			}
+			const auto it = this->dependents.find(index);
+			if (it != this->dependents.end())
+			{
+				for (auto dependent : it->second)
+				{
+					this->markDirty(dependent);
+				}
+			}
+		});
+	}
+
+	//--------------------------------------------------------------
+	void Expressions::clear()
+	{
+		this->listener.unsubscribe();
+		this->bindings.clear();
+		this->expressions.clear();
+		this->expressionByBinding.clear();
+		this->dependents.clear();
+		this->queue = decltype(this->queue)();
+		this->error.clear();
+	}
+
+	//--------------------------------------------------------------
+	bool Expressions::set(const string & targetPath, const string & expression)
+	{
+		const auto binding = this->bindings.indexOf(targetPath);
+		if (binding < 0)
+		{
+			this->error = "Parameter " + targetPath + " not found";
+			ofLogWarning(__FUNCTION__) << this->error << "!";
+			return false;
+		}
+		if (!this->bindings[binding].isNumeric())
+		{
+			this->error = "Parameter " + targetPath + " is not numeric";
+			ofLogWarning(__FUNCTION__) << this->error << "!";
+			return false;
+		}
+
+		Compiler compiler(this->bindings, expression);
+		if (!compiler.compileSum() || !compiler.error.empty())
+		{
+			this->error = compiler.error;
+			ofLogWarning(__FUNCTION__) << "Expression \"" << expression << "\" for " << targetPath << ": " << this->error << "!";
+			return false;
+		}
+		compiler.skipWhitespace();
+		if (compiler.str != compiler.end)
+		{
+			this->error = string("Unexpected character ") + *compiler.str;
+			ofLogWarning(__FUNCTION__) << "Expression \"" << expression << "\" for " << targetPath << ": " << this->error << "!";
+			return false;
+		}
+
+		Expression compiled;
+		compiled.target = targetPath;
+		compiled.source = expression;
+		compiled.binding = binding;
+		compiled.ops = std::move(compiler.ops);
+		compiled.inputs = std::move(compiler.inputs);
+		compiled.rank = 0;
+		compiled.dirty = false;
+
+		// Keep the previous version around in case the new one closes a cycle.
+		const auto existing = this->expressionByBinding[binding];
+		Expression previous;
+		if (existing >= 0)
+		{
+			previous = std::move(this->expressions[existing]);
+			this->expressions[existing] = std::move(compiled);
+		}
+		else
+		{
+			this->expressions.push_back(std::move(compiled));
+		}
+
+		if (!this->sort())
+		{
+			if (existing >= 0)
+			{
+				this->expressions[existing] = std::move(previous);
+			}
+			else
+			{
+				this->expressions.pop_back();
+			}
+			this->sort();
+
+			this->error = "Expression for " + targetPath + " creates a cycle";
+			ofLogWarning(__FUNCTION__) << this->error << "!";
+			return false;
+		}
+
+		this->error.clear();
+		this->markDirty(this->expressionByBinding[binding]);
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	bool Expressions::remove(const string & targetPath)
+	{
+		const auto index = this->indexOf(targetPath);
+		if (index < 0)
+		{
+			return false;
+		}
+		this->expressions.erase(this->expressions.begin() + index);
+		this->sort();
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	size_t Expressions::size() const
+	{
+		return this->expressions.size();
+	}
+
+	//--------------------------------------------------------------
+	bool Expressions::empty() const
+	{
+		return this->expressions.empty();
+	}
+
+	//--------------------------------------------------------------
+	const string & Expressions::getTarget(size_t index) const
+	{
+		return this->expressions[index].target;
+	}
+
+	//--------------------------------------------------------------
+	const string & Expressions::getExpression(size_t index) const
+	{
+		return this->expressions[index].source;
+	}
+
+	//--------------------------------------------------------------
+	int Expressions::indexOf(const string & targetPath) const
+	{
+		const auto binding = this->bindings.indexOf(targetPath);
+		return (binding < 0) ? -1 : this->expressionByBinding[binding];
+	}
+
+	//--------------------------------------------------------------
+	bool Expressions::isLinked(const ofAbstractParameter & parameter) const
+	{
+		const auto binding = this->bindings.indexOf(parameter);
+		return binding >= 0 && this->expressionByBinding[binding] >= 0;
+	}
+
+	//--------------------------------------------------------------
+	const string & Expressions::getError() const
+	{
+		return this->error;
+	}
+
+	//--------------------------------------------------------------
+	size_t Expressions::update()
+	{
+		// Evaluating an expression notifies its target, which queues the expressions
+		// reading it. Those always rank higher, so each one is evaluated once per pass.
+		size_t count = 0;
+		while (!this->queue.empty())
+		{
+			const auto index = this->queue.top().second;
+			this->queue.pop();
+
+			auto & expression = this->expressions[index];
+			if (!expression.dirty)
+			{
+				continue;
+			}
+			expression.dirty = false;
+			this->evaluate(expression);
+			++count;
+		}
+		return count;
+	}
+
+	//--------------------------------------------------------------
+	bool Expressions::sort()
+	{
+		// Rebuild the lookups, the indices may have moved.
+		std::fill(this->expressionByBinding.begin(), this->expressionByBinding.end(), -1);
+		this->dependents.clear();
+		for (size_t i = 0; i < this->expressions.size(); ++i)
+		{
+			this->expressionByBinding[this->expressions[i].binding] = i;
+			for (auto input : this->expressions[i].inputs)
+			{
+				this->dependents[input].push_back(i);
+			}
+		}
+
+		// Kahn's algorithm, ranking each expression by its longest chain of linked inputs.
+		vector<size_t> numLinkedInputs(this->expressions.size(), 0);
+		vector<size_t> ready;
+		for (size_t i = 0; i < this->expressions.size(); ++i)
+		{
+			auto & expression = this->expressions[i];
+			expression.rank = 0;
+			for (auto input : expression.inputs)
+			{
+				if (this->expressionByBinding[input] >= 0)
+				{
+					++numLinkedInputs[i];
+				}
+			}
+			if (numLinkedInputs[i] == 0)
+			{
+				ready.push_back(i);
+			}
+		}
+
+		size_t numSorted = 0;
+		while (!ready.empty())
+		{
+			const auto index = ready.back();
+			ready.pop_back();
+			++numSorted;
+
+			const auto it = this->dependents.find(this->expressions[index].binding);
+			if (it == this->dependents.end())
+			{
+				continue;
+			}
+			for (auto dependent : it->second)
+			{
+				auto & rank = this->expressions[dependent].rank;
+				rank = std::max(rank, this->expressions[index].rank + 1);
+				if (--numLinkedInputs[dependent] == 0)
+				{
+					ready.push_back(dependent);
+				}
+			}
+		}
+
+		// Ranks changed, queue the pending expressions again.
+		this->queue = decltype(this->queue)();
+		for (size_t i = 0; i < this->expressions.size(); ++i)
+		{
+			if (this->expressions[i].dirty)
+			{
+				this->queue.emplace(this->expressions[i].rank, i);
+			}
+		}
+
+		return numSorted == this->expressions.size();
+	}
+
+	//--------------------------------------------------------------
+	void Expressions::markDirty(size_t index)
+	{
+		auto & expression = this->expressions[index];
+		if (!expression.dirty)
+		{
+			expression.dirty = true;
+			this->queue.emplace(expression.rank, index);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Expressions::evaluate(Expression & expression)
+	{
+		const auto & target = this->bindings[expression.binding];
+
+		float values[Binding::kMaxComponents];
+		const auto numComponents = target.getComponents(values);
+
+		// The stack never grows deeper than the program.
+		if (this->stack.size() < expression.ops.size())
+		{
+			this->stack.resize(expression.ops.size());
+		}
+
+		for (size_t c = 0; c < numComponents; ++c)
+		{
+			auto top = this->stack.data();
+			for (const auto & op : expression.ops)
+			{
+				switch (op.code)
+				{
+				case OpCode::Constant:
+					*top++ = op.value;
+					break;
+				case OpCode::Load:
+				{
+					// Scalars apply to every component, missing components read as 0.
+					float components[Binding::kMaxComponents];
+					const auto count = this->bindings[op.binding].getComponents(components);
+					*top++ = (count == 1) ? components[0] : (c < count ? components[c] : 0.0f);
+					break;
+				}
+				case OpCode::Add:
+					--top;
+					top[-1] += top[0];
+					break;
+				case OpCode::Subtract:
+					--top;
+					top[-1] -= top[0];
+					break;
+				case OpCode::Multiply:
+					--top;
+					top[-1] *= top[0];
+					break;
+				case OpCode::Divide:
+					--top;
+					top[-1] /= top[0];
+					break;
+				case OpCode::Modulo:
+					--top;
+					top[-1] = fmodf(top[-1], top[0]);
+					break;
+				case OpCode::Negate:
+					top[-1] = -top[-1];
+					break;
+				case OpCode::Call:
+				{
+					top -= op.numArguments;
+					top[0] = Call(op.function, top);
+					++top;
+					break;
+				}
+				}
+			}
+
+			// Keep the current value rather than writing NaN or infinity.
+			const auto result = this->stack[0];
+			if (std::isfinite(result))
+			{
+				values[c] = result;
+			}
+		}
+
+		target.setComponents(values);
+	}
+}
@@ -1,7 +1,17 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include "ofxImGui.h"
 
+#include "AssetPath.h"
+#include "Expressions.h"
+#include "History.h"
+#include "Modulation.h"
+#include "Profiler.h"
+#include "SearchIndex.h"
+
 static const int kGuiMargin = 10;
 
 namespace ofxPreset
@@ -9,12 +19,6 @@ namespace ofxPreset
 	class Gui
 	{
 	public:
-		struct WindowOpen
-		{
-			std::stack<std::vector<std::string>> usedNames;
-			shared_ptr<ofParameter<bool>> parameter;
-			bool value;
-		};
 	
 		struct Settings
 		{
@@ -30,7 +34,36 @@ namespace ofxPreset
 			ofRectangle screenBounds;
 		};
 
-		static WindowOpen windowOpen;
+		// When widgets set their parameter, for parameters with expensive listeners.
+		enum class CommitMode
+		{
+			// On every change.
+			Immediate,
+			// Once, when the widget is released.
+			OnRelease,
+			// At most rate times per second while the widget is held, and when it is released.
+			RateLimited
+		};
+
+		struct CommitPolicy
+		{
+			CommitMode mode;
+			float rate;
+		};
+
+		// Applies to the widgets added until the matching pop, e.g. for a whole window.
+		static inline void PushCommitPolicy(CommitMode mode, float rate = 10.0f);
+		static inline void PopCommitPolicy();
+
+		// Overrides the current policy for a single parameter, in every context.
+		// Set these up front if the GUIs are built on several threads.
+		template<typename ParameterType>
+		static inline void SetCommitPolicy(const ofParameter<ParameterType> & parameter, CommitMode mode, float rate = 10.0f);
+		template<typename ParameterType>
+		static inline void ClearCommitPolicy(const ofParameter<ParameterType> & parameter);
+
+		// Releases the state kept for an ImGui context, call it when destroying the context (the current one by default).
+		static inline void ReleaseContext(ImGuiContext * imGuiContext = nullptr);
 
 		static inline const char * GetUniqueName(ofAbstractParameter & parameter); 
 		static inline const char * GetUniqueName(const std::string & candidate);
@@ -45,6 +78,10 @@ namespace ofxPreset
 		static inline void EndTree(Settings & settings);
 
 		static inline void AddGroup(ofParameterGroup & group, Settings & settings);
+
+		// Filter box followed by the parameters of the index's group that match it, all of them if it is empty.
+		// Must be called inside a window.
+		static inline void AddSearch(SearchIndex & index, Settings & settings);
 	
         static inline bool AddParameter(ofParameter<glm::tvec2<int>> & parameter);
         static inline bool AddParameter(ofParameter<glm::tvec3<int>> & parameter);
@@ -60,6 +97,12 @@ namespace ofxPreset
         
         static inline bool AddParameter(ofParameter<ofFloatColor> & parameter, bool alpha = true);
 
+		// Editable path with a button to pick the file from a dialog.
+		static inline bool AddParameter(ofParameter<AssetPath> & parameter);
+
+		// Any parameter type we know how to handle.
+		static inline bool AddParameter(const shared_ptr<ofAbstractParameter> & parameter);
+
 		template<typename ParameterType>
 		static inline bool AddParameter(ofParameter<ParameterType> & parameter);
 
@@ -68,6 +111,9 @@ namespace ofxPreset
 
 		static inline bool AddRange(const string & name, ofParameter<float> & parameterMin, ofParameter<float> & parameterMax, float speed = 0.01f);
 
+		// Only shows the settings that apply to the selected shape.
+		static inline bool AddModulator(Modulator & modulator, Settings & settings);
+
 		static inline bool AddValues(const string & name, vector<glm::tvec2<int>> & values, int minValue, int maxValue);
 		static inline bool AddValues(const string & name, vector<glm::tvec3<int>> & values, int minValue, int maxValue);
 		static inline bool AddValues(const string & name, vector<glm::tvec4<int>> & values, int minValue, int maxValue);
@@ -83,8 +129,83 @@ namespace ofxPreset
 		template<typename DataType>
 		static inline bool AddValues(const string & name, vector<DataType> & values, DataType minValue, DataType maxValue);
 
+		// Lists the parameters by listener cost, most expensive first. Must be called inside a window block.
+		static inline void AddProfiler(Profiler & profiler, Settings & settings);
+
+		// Edits the expressions in place (Enter applies, an empty expression removes the link), and links new targets.
+		// Must be called inside a window block.
+		static inline void AddExpressions(Expressions & expressions, Settings & settings);
+
+		// Plots the recorded values of the parameter, one line per component, scaled to its range.
+		static inline bool AddHistory(const History & history, const ofAbstractParameter & parameter, const ofVec2f & size = ofVec2f(0.0f, 40.0f));
+
 		static inline void AddImage(ofBaseHasTexture & hasTexture, const ofVec2f & size);
 		static inline void AddImage(ofTexture & texture, const ofVec2f & size);
+
+	protected:
+		struct PendingValueBase
+		{
+			bool dirty;
+			float commitTime;
+			// ImGui frame the widget was last submitted in.
+			int frame;
+		};
+
+		template<typename ParameterType>
+		struct PendingValue
+			: PendingValueBase
+		{
+			ParameterType value;
+		};
+
+		// Window and widget state, one per ImGui context, so separate contexts can be built independently,
+		// on separate threads if ImGui's current context is thread local.
+		struct Context
+		{
+			std::stack<std::vector<std::string>> usedNames;
+			shared_ptr<ofParameter<bool>> parameter;
+			bool value;
+
+			vector<CommitPolicy> commitPolicies;
+			// Typed PendingValue, keyed by the address of the value.
+			unordered_map<const void *, shared_ptr<PendingValueBase>> pendingValues;
+
+			// Draft of the link being added by AddExpressions().
+			char newTarget[256];
+			char newExpression[512];
+		};
+
+		struct ContextCache
+		{
+			const ImGuiContext * imGuiContext;
+			Context * context;
+			uint64_t generation;
+		};
+
+		// State of the current ImGui context.
+		static inline Context & GetContext();
+		static inline std::mutex & GetContextMutex();
+		static inline unordered_map<const ImGuiContext *, unique_ptr<Context>> & GetContexts();
+		// Bumped whenever a context is released, so the per-thread caches look it up again.
+		static inline std::atomic<uint64_t> & GetContextGeneration();
+
+		static inline vector<CommitPolicy> & GetCommitPolicies();
+		static inline unordered_map<const void *, CommitPolicy> & GetParameterCommitPolicies();
+		// Drops the values of widgets that were not submitted last frame, e.g. hidden in the middle of a drag, without committing them.
+		static inline void DropStalePendingValues(Context & context);
+		// Returns nullptr if the parameter has no pending value and create is false.
+		template<typename ParameterType>
+		static inline PendingValue<ParameterType> * GetPendingValue(const ofParameter<ParameterType> & parameter, bool create);
+
+		// Value to show in the widget, the one being edited if it is not committed yet.
+		template<typename ParameterType>
+		static inline ParameterType GetEditValue(const ofParameter<ParameterType> & parameter);
+
+		// Sets the parameter as the commit policy allows, must be called right after the widget.
+		template<typename ParameterType>
+		static inline bool CommitValue(ofParameter<ParameterType> & parameter, const ParameterType & value, bool changed);
+
+		static inline void AddSearchNode(SearchIndex & index, int node, Settings & settings);
     };
 }
 
@@ -20,13 +20,240 @@ namespace ofxPreset
 	//--------------------------------------------------------------
 	const char * Gui::GetUniqueName(const std::string & candidate)
 	{
+		auto & usedNames = GetContext().usedNames.top();
 		std::string result = candidate;
-		while (std::find(windowOpen.usedNames.top().begin(), windowOpen.usedNames.top().end(), result) != windowOpen.usedNames.top().end())
+		while (std::find(usedNames.begin(), usedNames.end(), result) != usedNames.end())
 		{
 			result += " ";
 		}
-		windowOpen.usedNames.top().push_back(result);
-		return windowOpen.usedNames.top().back().c_str();
+		usedNames.push_back(result);
+		return usedNames.back().c_str();
+	}
+
+	//--------------------------------------------------------------
+	void Gui::ReleaseContext(ImGuiContext * imGuiContext)
+	{
+		if (!imGuiContext)
+		{
+			imGuiContext = ImGui::GetCurrentContext();
+		}
+
+		std::lock_guard<std::mutex> lock(GetContextMutex());
+		if (GetContexts().erase(imGuiContext))
+		{
+			++GetContextGeneration();
+		}
+	}
+
+	//--------------------------------------------------------------
+	Gui::Context & Gui::GetContext()
+	{
+		// Most calls come from the same context as the previous one on this thread, skip the lock.
+		static thread_local ContextCache cache = { nullptr, nullptr, 0 };
+		const auto imGuiContext = ImGui::GetCurrentContext();
+		const auto generation = GetContextGeneration().load();
+		if (cache.context && cache.imGuiContext == imGuiContext && cache.generation == generation)
+		{
+			return *cache.context;
+		}
+
+		std::lock_guard<std::mutex> lock(GetContextMutex());
+		auto & context = GetContexts()[imGuiContext];
+		if (!context)
+		{
+			context.reset(new Context());
+			context->value = false;
+			context->newTarget[0] = '\0';
+			context->newExpression[0] = '\0';
+		}
+		cache.imGuiContext = imGuiContext;
+		cache.context = context.get();
+		cache.generation = generation;
+		return *context;
+	}
+
+	//--------------------------------------------------------------
+	std::mutex & Gui::GetContextMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	//--------------------------------------------------------------
+	unordered_map<const ImGuiContext *, unique_ptr<Gui::Context>> & Gui::GetContexts()
+	{
+		static unordered_map<const ImGuiContext *, unique_ptr<Context>> contexts;
+		return contexts;
+	}
+
+	//--------------------------------------------------------------
+	std::atomic<uint64_t> & Gui::GetContextGeneration()
+	{
+		static std::atomic<uint64_t> generation(0);
+		return generation;
+	}
+
+	//--------------------------------------------------------------
+	void Gui::PushCommitPolicy(CommitMode mode, float rate)
+	{
+		GetCommitPolicies().push_back(CommitPolicy{ mode, rate });
+	}
+
+	//--------------------------------------------------------------
+	void Gui::PopCommitPolicy()
+	{
+		if (GetCommitPolicies().empty())
+		{
+			ofLogWarning(__FUNCTION__) << "No commit policy to pop!";
+			return;
+		}
+		GetCommitPolicies().pop_back();
+	}
+
+	//--------------------------------------------------------------
+	template<typename ParameterType>
+	void Gui::SetCommitPolicy(const ofParameter<ParameterType> & parameter, CommitMode mode, float rate)
+	{
+		GetParameterCommitPolicies()[&parameter.get()] = CommitPolicy{ mode, rate };
+	}
+
+	//--------------------------------------------------------------
+	template<typename ParameterType>
+	void Gui::ClearCommitPolicy(const ofParameter<ParameterType> & parameter)
+	{
+		GetParameterCommitPolicies().erase(&parameter.get());
+	}
+
+	//--------------------------------------------------------------
+	vector<Gui::CommitPolicy> & Gui::GetCommitPolicies()
+	{
+		return GetContext().commitPolicies;
+	}
+
+	//--------------------------------------------------------------
+	unordered_map<const void *, Gui::CommitPolicy> & Gui::GetParameterCommitPolicies()
+	{
+		// Keyed by the address of the value, which is shared by all references to the same parameter.
+		static unordered_map<const void *, CommitPolicy> policies;
+		return policies;
+	}
+
+	//--------------------------------------------------------------
+	void Gui::DropStalePendingValues(Context & context)
+	{
+		const auto frame = ImGui::GetFrameCount();
+		auto it = context.pendingValues.begin();
+		while (it != context.pendingValues.end())
+		{
+			if (it->second->frame < frame - 1)
+			{
+				it = context.pendingValues.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	//--------------------------------------------------------------
+	template<typename ParameterType>
+	Gui::PendingValue<ParameterType> * Gui::GetPendingValue(const ofParameter<ParameterType> & parameter, bool create)
+	{
+		auto & context = GetContext();
+		if (!context.pendingValues.empty())
+		{
+			DropStalePendingValues(context);
+
+			// The address of a value always holds the same type, so the cast back is safe.
+			const auto it = context.pendingValues.find(&parameter.get());
+			if (it != context.pendingValues.end())
+			{
+				return static_cast<PendingValue<ParameterType> *>(it->second.get());
+			}
+		}
+		if (!create)
+		{
+			return nullptr;
+		}
+
+		auto pendingValue = make_shared<PendingValue<ParameterType>>();
+		pendingValue->value = parameter.get();
+		pendingValue->dirty = false;
+		pendingValue->commitTime = 0.0f;
+		pendingValue->frame = ImGui::GetFrameCount();
+		context.pendingValues[&parameter.get()] = pendingValue;
+		return pendingValue.get();
+	}
+
+	//--------------------------------------------------------------
+	template<typename ParameterType>
+	ParameterType Gui::GetEditValue(const ofParameter<ParameterType> & parameter)
+	{
+		const auto pendingValue = GetPendingValue(parameter, false);
+		return pendingValue ? pendingValue->value : parameter.get();
+	}
+
+	//--------------------------------------------------------------
+	template<typename ParameterType>
+	bool Gui::CommitValue(ofParameter<ParameterType> & parameter, const ParameterType & value, bool changed)
+	{
+		auto policy = CommitPolicy{ CommitMode::Immediate, 0.0f };
+		const auto & parameterPolicies = GetParameterCommitPolicies();
+		const auto policyIt = parameterPolicies.find(&parameter.get());
+		if (policyIt != parameterPolicies.end())
+		{
+			policy = policyIt->second;
+		}
+		else if (!GetCommitPolicies().empty())
+		{
+			policy = GetCommitPolicies().back();
+		}
+
+		if (policy.mode == CommitMode::Immediate)
+		{
+			if (changed)
+			{
+				parameter.set(value);
+			}
+			return changed;
+		}
+
+		// Keep the edited value, the widget shows it until it is committed.
+		auto pendingValue = GetPendingValue(parameter, changed);
+		if (!pendingValue)
+		{
+			return false;
+		}
+		if (changed)
+		{
+			pendingValue->value = value;
+			pendingValue->dirty = true;
+		}
+		pendingValue->frame = ImGui::GetFrameCount();
+
+		// Only one widget can be active, and it is the last item when it was just submitted.
+		const auto active = ImGui::IsItemActive();
+		const auto now = ofGetElapsedTimef();
+		auto commit = !active;
+		if (active && policy.mode == CommitMode::RateLimited && policy.rate > 0.0f)
+		{
+			commit = (now - pendingValue->commitTime) >= 1.0f / policy.rate;
+		}
+
+		auto result = false;
+		if (commit && pendingValue->dirty)
+		{
+			pendingValue->dirty = false;
+			pendingValue->commitTime = now;
+			parameter.set(pendingValue->value);
+			result = true;
+		}
+		if (!active)
+		{
+			GetContext().pendingValues.erase(&parameter.get());
+		}
+		return result;
 	}
 
 	//--------------------------------------------------------------
@@ -46,11 +273,12 @@ namespace ofxPreset
 		}
 		
 		// Reference this ofParameter until EndWindow().
-		windowOpen.parameter = dynamic_pointer_cast<ofParameter<bool>>(parameter.newReference());
-		windowOpen.value = parameter.get();
+		auto & context = GetContext();
+		context.parameter = dynamic_pointer_cast<ofParameter<bool>>(parameter.newReference());
+		context.value = parameter.get();
 
-		auto result = Gui::BeginWindow(parameter.getName(), settings, collapse, &windowOpen.value);
-		parameter = windowOpen.value;
+		auto result = Gui::BeginWindow(parameter.getName(), settings, collapse, &context.value);
+		parameter = context.value;
 		return result;
 	}
 
@@ -66,7 +294,7 @@ namespace ofxPreset
 		settings.windowBlock = true;
 
 		// Push a new list of names onto the stack.
-		windowOpen.usedNames.push(std::vector<std::string>());
+		GetContext().usedNames.push(std::vector<std::string>());
 
 		ImGui::SetNextWindowPos(settings.windowPos, ImGuiSetCond_Appearing);
 		ImGui::SetNextWindowSize(settings.windowSize, ImGuiSetCond_Appearing);
@@ -89,11 +317,13 @@ namespace ofxPreset
 		settings.windowSize = ImGui::GetWindowSize();
 		ImGui::End();
 
+		auto & context = GetContext();
+
 		// Unlink the referenced ofParameter.
-		windowOpen.parameter.reset();
+		context.parameter.reset();
 
 		// Clear the list of names from the stack.
-		windowOpen.usedNames.pop();
+		context.usedNames.pop();
 
 		// Check if the mouse cursor is over this gui window.
 		const auto windowBounds = ofRectangle(settings.windowPos, settings.windowSize.x, settings.windowSize.y);
@@ -134,7 +364,7 @@ namespace ofxPreset
 			settings.treeLevel += 1;
 
 			// Push a new list of names onto the stack.
-			windowOpen.usedNames.push(std::vector<std::string>());
+			GetContext().usedNames.push(std::vector<std::string>());
 		}
 		return result;
 	}
@@ -145,7 +375,7 @@ namespace ofxPreset
 		settings.treeLevel = std::max(0, settings.treeLevel - 1);
 
 		// Clear the list of names from the stack.
-		windowOpen.usedNames.pop();
+		GetContext().usedNames.pop();
 
 		ImGui::TreePop();
 	}
@@ -181,69 +411,8 @@ namespace ofxPreset
 				continue;
 			}
 
-			// Parameter, try everything we know how to handle.
-			auto parameterVec2f = dynamic_pointer_cast<ofParameter<glm::vec2>>(parameter);
-			if (parameterVec2f)
-			{
-				Gui::AddParameter(*parameterVec2f);
-				continue;
-			}
-			auto parameterVec3f = dynamic_pointer_cast<ofParameter<glm::vec3>>(parameter);
-			if (parameterVec3f)
-			{
-				Gui::AddParameter(*parameterVec3f);
-				continue;
-			}
-			auto parameterVec4f = dynamic_pointer_cast<ofParameter<glm::vec4>>(parameter);
-			if (parameterVec4f)
-			{
-				Gui::AddParameter(*parameterVec4f);
-				continue;
-			}
-			auto parameterOfVec2f = dynamic_pointer_cast<ofParameter<ofVec2f>>(parameter);
-			if (parameterOfVec2f)
-			{
-				Gui::AddParameter(*parameterOfVec2f);
-				continue;
-			}
-			auto parameterOfVec3f = dynamic_pointer_cast<ofParameter<ofVec3f>>(parameter);
-			if (parameterOfVec3f)
-			{
-				Gui::AddParameter(*parameterOfVec3f);
-				continue;
-			}
-			auto parameterOfVec4f = dynamic_pointer_cast<ofParameter<ofVec4f>>(parameter);
-			if (parameterOfVec4f)
-			{
-				Gui::AddParameter(*parameterOfVec4f);
-				continue;
-			}
-			auto parameterFloatColor = dynamic_pointer_cast<ofParameter<ofFloatColor>>(parameter);
-			if (parameterFloatColor)
-			{
-				Gui::AddParameter(*parameterFloatColor);
-				continue;
-			}
-			auto parameterFloat = dynamic_pointer_cast<ofParameter<float>>(parameter);
-			if (parameterFloat)
-			{
-				Gui::AddParameter(*parameterFloat);
-				continue;
-			}
-			auto parameterInt = dynamic_pointer_cast<ofParameter<int>>(parameter);
-			if (parameterInt)
-			{
-				Gui::AddParameter(*parameterInt);
-				continue;
-			}
-			auto parameterBool = dynamic_pointer_cast<ofParameter<bool>>(parameter);
-			if (parameterBool)
-			{
-				Gui::AddParameter(*parameterBool);
-				continue;
-			}
-
-			ofLogWarning(__FUNCTION__) << "Could not create GUI element for parameter " << parameter->getName();
+			// Parameter.
+			Gui::AddParameter(parameter);
 		}
 
 		if (settings.windowBlock && !prevWindowBlock)
@@ -259,165 +428,233 @@ namespace ofxPreset
 	}
 
 	//--------------------------------------------------------------
-	bool Gui::AddParameter(ofParameter<glm::tvec2<int>> & parameter)
+	void Gui::AddSearch(SearchIndex & index, Settings & settings)
 	{
-		auto tmpRef = parameter.get();
-		if (ImGui::SliderInt2(GetUniqueName(parameter), glm::value_ptr(tmpRef), parameter.getMin().x, parameter.getMax().x))
+		if (!settings.windowBlock)
 		{
-			parameter.set(tmpRef);
-			return true;
+			ofLogWarning(__FUNCTION__) << "Not inside a window block!";
+			return;
+		}
+
+		// Pick up groups that changed since the last frame.
+		index.update();
+
+		char buffer[256];
+		strncpy(buffer, index.getQuery().c_str(), sizeof(buffer) - 1);
+		buffer[sizeof(buffer) - 1] = '\0';
+		if (ImGui::InputText(GetUniqueName("Filter"), buffer, sizeof(buffer)))
+		{
+			index.search(buffer);
+		}
+
+		if (index.getQuery().empty())
+		{
+			Gui::AddGroup(index.getGroup(), settings);
+		}
+		else if (index.size() && index.isVisible(0))
+		{
+			Gui::AddSearchNode(index, 0, settings);
 		}
-		return false;
 	}
 
 	//--------------------------------------------------------------
-	bool Gui::AddParameter(ofParameter<glm::tvec3<int>> & parameter)
+	bool Gui::AddParameter(const shared_ptr<ofAbstractParameter> & parameter)
 	{
-		auto tmpRef = parameter.get();
-		if (ImGui::SliderInt3(GetUniqueName(parameter), glm::value_ptr(tmpRef), parameter.getMin().x, parameter.getMax().x))
+		// Try everything we know how to handle.
+		auto parameterVec2f = dynamic_pointer_cast<ofParameter<glm::vec2>>(parameter);
+		if (parameterVec2f)
 		{
-			parameter.set(tmpRef);
-			return true;
+			return Gui::AddParameter(*parameterVec2f);
 		}
+		auto parameterVec3f = dynamic_pointer_cast<ofParameter<glm::vec3>>(parameter);
+		if (parameterVec3f)
+		{
+			return Gui::AddParameter(*parameterVec3f);
+		}
+		auto parameterVec4f = dynamic_pointer_cast<ofParameter<glm::vec4>>(parameter);
+		if (parameterVec4f)
+		{
+			return Gui::AddParameter(*parameterVec4f);
+		}
+		auto parameterOfVec2f = dynamic_pointer_cast<ofParameter<ofVec2f>>(parameter);
+		if (parameterOfVec2f)
+		{
+			return Gui::AddParameter(*parameterOfVec2f);
+		}
+		auto parameterOfVec3f = dynamic_pointer_cast<ofParameter<ofVec3f>>(parameter);
+		if (parameterOfVec3f)
+		{
+			return Gui::AddParameter(*parameterOfVec3f);
+		}
+		auto parameterOfVec4f = dynamic_pointer_cast<ofParameter<ofVec4f>>(parameter);
+		if (parameterOfVec4f)
+		{
+			return Gui::AddParameter(*parameterOfVec4f);
+		}
+		auto parameterFloatColor = dynamic_pointer_cast<ofParameter<ofFloatColor>>(parameter);
+		if (parameterFloatColor)
+		{
+			return Gui::AddParameter(*parameterFloatColor);
+		}
+		auto parameterAssetPath = dynamic_pointer_cast<ofParameter<AssetPath>>(parameter);
+		if (parameterAssetPath)
+		{
+			return Gui::AddParameter(*parameterAssetPath);
+		}
+		auto parameterFloat = dynamic_pointer_cast<ofParameter<float>>(parameter);
+		if (parameterFloat)
+		{
+			return Gui::AddParameter(*parameterFloat);
+		}
+		auto parameterInt = dynamic_pointer_cast<ofParameter<int>>(parameter);
+		if (parameterInt)
+		{
+			return Gui::AddParameter(*parameterInt);
+		}
+		auto parameterBool = dynamic_pointer_cast<ofParameter<bool>>(parameter);
+		if (parameterBool)
+		{
+			return Gui::AddParameter(*parameterBool);
+		}
+
+		ofLogWarning(__FUNCTION__) << "Could not create GUI element for parameter " << parameter->getName();
 		return false;
 	}
 
+	//--------------------------------------------------------------
+	bool Gui::AddParameter(ofParameter<glm::tvec2<int>> & parameter)
+	{
+		auto tmpRef = Gui::GetEditValue(parameter);
+		const auto changed = ImGui::SliderInt2(GetUniqueName(parameter), glm::value_ptr(tmpRef), parameter.getMin().x, parameter.getMax().x);
+		return Gui::CommitValue(parameter, tmpRef, changed);
+	}
+
+	//--------------------------------------------------------------
+	bool Gui::AddParameter(ofParameter<glm::tvec3<int>> & parameter)
+	{
+		auto tmpRef = Gui::GetEditValue(parameter);
+		const auto changed = ImGui::SliderInt3(GetUniqueName(parameter), glm::value_ptr(tmpRef), parameter.getMin().x, parameter.getMax().x);
+		return Gui::CommitValue(parameter, tmpRef, changed);
+	}
+
 	//--------------------------------------------------------------
 	bool Gui::AddParameter(ofParameter<glm::tvec4<int>> & parameter)
 	{
-		auto tmpRef = parameter.get();
-		if (ImGui::SliderInt4(GetUniqueName(parameter), glm::value_ptr(tmpRef), parameter.getMin().x, parameter.getMax().x))
-		{
-			parameter.set(tmpRef);
-			return true;
-		}
-		return false;
+		auto tmpRef = Gui::GetEditValue(parameter);
+		const auto changed = ImGui::SliderInt4(GetUniqueName(parameter), glm::value_ptr(tmpRef), parameter.getMin().x, parameter.getMax().x);
+		return Gui::CommitValue(parameter, tmpRef, changed);
 	}
 
 	//--------------------------------------------------------------
 	bool Gui::AddParameter(ofParameter<glm::vec2> & parameter)
 	{
-		auto tmpRef = parameter.get();
-		if (ImGui::SliderFloat2(GetUniqueName(parameter), glm::value_ptr(tmpRef), parameter.getMin().x, parameter.getMax().x))
-		{
-			parameter.set(tmpRef);
-			return true;
-		}
-		return false;
+		auto tmpRef = Gui::GetEditValue(parameter);
+		const auto changed = ImGui::SliderFloat2(GetUniqueName(parameter), glm::value_ptr(tmpRef), parameter.getMin().x, parameter.getMax().x);
+		return Gui::CommitValue(parameter, tmpRef, changed);
 	}
 
 	//--------------------------------------------------------------
 	bool Gui::AddParameter(ofParameter<glm::vec3> & parameter)
 	{
-		auto tmpRef = parameter.get();
-		if (ImGui::SliderFloat3(GetUniqueName(parameter), glm::value_ptr(tmpRef), parameter.getMin().x, parameter.getMax().x))
-		{
-			parameter.set(tmpRef);
-			return true;
-		}
-		return false;
+		auto tmpRef = Gui::GetEditValue(parameter);
+		const auto changed = ImGui::SliderFloat3(GetUniqueName(parameter), glm::value_ptr(tmpRef), parameter.getMin().x, parameter.getMax().x);
+		return Gui::CommitValue(parameter, tmpRef, changed);
 	}
 
 	//--------------------------------------------------------------
 	bool Gui::AddParameter(ofParameter<glm::vec4> & parameter)
 	{
-		auto tmpRef = parameter.get();
-		if (ImGui::SliderFloat4(GetUniqueName(parameter), glm::value_ptr(tmpRef), parameter.getMin().x, parameter.getMax().x))
-		{
-			parameter.set(tmpRef);
-			return true;
-		}
-		return false;
+		auto tmpRef = Gui::GetEditValue(parameter);
+		const auto changed = ImGui::SliderFloat4(GetUniqueName(parameter), glm::value_ptr(tmpRef), parameter.getMin().x, parameter.getMax().x);
+		return Gui::CommitValue(parameter, tmpRef, changed);
 	}
 
 	//--------------------------------------------------------------
 	bool Gui::AddParameter(ofParameter<ofVec2f> & parameter)
 	{
-		auto tmpRef = parameter.get();
-		if (ImGui::SliderFloat2(GetUniqueName(parameter), tmpRef.getPtr(), parameter.getMin().x, parameter.getMax().x))
-		{
-			parameter.set(tmpRef);
-			return true;
-		}
-		return false;
+		auto tmpRef = Gui::GetEditValue(parameter);
+		const auto changed = ImGui::SliderFloat2(GetUniqueName(parameter), tmpRef.getPtr(), parameter.getMin().x, parameter.getMax().x);
+		return Gui::CommitValue(parameter, tmpRef, changed);
 	}
 
 	//--------------------------------------------------------------
 	bool Gui::AddParameter(ofParameter<ofVec3f> & parameter)
 	{
-		auto tmpRef = parameter.get();
-		if (ImGui::SliderFloat3(GetUniqueName(parameter), tmpRef.getPtr(), parameter.getMin().x, parameter.getMax().x))
-		{
-			parameter.set(tmpRef);
-			return true;
-		}
-		return false;
+		auto tmpRef = Gui::GetEditValue(parameter);
+		const auto changed = ImGui::SliderFloat3(GetUniqueName(parameter), tmpRef.getPtr(), parameter.getMin().x, parameter.getMax().x);
+		return Gui::CommitValue(parameter, tmpRef, changed);
 	}
 
 	//--------------------------------------------------------------
 	bool Gui::AddParameter(ofParameter<ofVec4f> & parameter)
 	{
-		auto tmpRef = parameter.get();
-		if (ImGui::SliderFloat4(GetUniqueName(parameter), tmpRef.getPtr(), parameter.getMin().x, parameter.getMax().x))
-		{
-			parameter.set(tmpRef);
-			return true;
-		}
-		return false;
+		auto tmpRef = Gui::GetEditValue(parameter);
+		const auto changed = ImGui::SliderFloat4(GetUniqueName(parameter), tmpRef.getPtr(), parameter.getMin().x, parameter.getMax().x);
+		return Gui::CommitValue(parameter, tmpRef, changed);
 	}
 
 	//--------------------------------------------------------------
 	bool Gui::AddParameter(ofParameter<ofFloatColor> & parameter, bool alpha)
 	{
-		auto tmpRef = parameter.get();
-		if (alpha)
+		auto tmpRef = Gui::GetEditValue(parameter);
+		const auto changed = alpha ? ImGui::ColorEdit4(GetUniqueName(parameter), &tmpRef.r) : ImGui::ColorEdit3(GetUniqueName(parameter), &tmpRef.r);
+		return Gui::CommitValue(parameter, tmpRef, changed);
+	}
+
+	//--------------------------------------------------------------
+	bool Gui::AddParameter(ofParameter<AssetPath> & parameter)
+	{
+		auto result = false;
+		const auto name = GetUniqueName(parameter);
+		ImGui::PushID(name);
 		{
-			if (ImGui::ColorEdit4(GetUniqueName(parameter), &tmpRef.r))
+			char buffer[1024];
+			strncpy(buffer, parameter.get().path.c_str(), sizeof(buffer) - 1);
+			buffer[sizeof(buffer) - 1] = '\0';
+
+			// Only apply when done typing, every change starts loading a file.
+			if (ImGui::InputText("##Path", buffer, sizeof(buffer), ImGuiInputTextFlags_EnterReturnsTrue))
 			{
-				parameter.set(tmpRef);
-				return true;
+				parameter.set(AssetPath(buffer));
+				result = true;
 			}
+			ImGui::SameLine();
+			if (ImGui::Button("..."))
+			{
+				auto dialogResult = ofSystemLoadDialog(parameter.getName(), false, ofToDataPath(""));
+				if (dialogResult.bSuccess)
+				{
+					parameter.set(AssetPath(ofFilePath::makeRelative(ofToDataPath(""), dialogResult.filePath)));
+					result = true;
+				}
+			}
+			ImGui::SameLine();
+			ImGui::Text("%s", parameter.getName().c_str());
 		}
-		else if (ImGui::ColorEdit3(GetUniqueName(parameter), &tmpRef.r))
-		{
-			parameter.set(tmpRef);
-			return true;
-		}
-		return false;
+		ImGui::PopID();
+		return result;
 	}
 
 	//--------------------------------------------------------------
 	template<typename ParameterType>
 	bool Gui::AddParameter(ofParameter<ParameterType> & parameter)
 	{
-		auto tmpRef = parameter.get();
+		auto tmpRef = Gui::GetEditValue(parameter);
 		const auto & info = typeid(ParameterType);
 		if (info == typeid(float))
 		{
-			if (ImGui::SliderFloat(GetUniqueName(parameter), (float *)&tmpRef, parameter.getMin(), parameter.getMax()))
-			{
-				parameter.set(tmpRef);
-				return true;
-			}
-			return false;
+			const auto changed = ImGui::SliderFloat(GetUniqueName(parameter), (float *)&tmpRef, parameter.getMin(), parameter.getMax());
+			return Gui::CommitValue(parameter, tmpRef, changed);
 		}
 		if (info == typeid(int))
 		{
-			if (ImGui::SliderInt(GetUniqueName(parameter), (int *)&tmpRef, parameter.getMin(), parameter.getMax()))
-			{
-				parameter.set(tmpRef);
-				return true;
-			}
-			return false;
+			const auto changed = ImGui::SliderInt(GetUniqueName(parameter), (int *)&tmpRef, parameter.getMin(), parameter.getMax());
+			return Gui::CommitValue(parameter, tmpRef, changed);
 		}
 		if (info == typeid(bool))
 		{
-			if (ImGui::Checkbox(GetUniqueName(parameter), (bool *)&tmpRef))
-			{
-				parameter.set(tmpRef);
-				return true;
-			}
-			return false;
+			const auto changed = ImGui::Checkbox(GetUniqueName(parameter), (bool *)&tmpRef);
+			return Gui::CommitValue(parameter, tmpRef, changed);
 		}
 
 		ofLogWarning(__FUNCTION__) << "Could not create GUI element for type " << info.name();
@@ -451,27 +688,55 @@ namespace ofxPreset
 	//--------------------------------------------------------------
 	bool Gui::AddStepper(ofParameter<int> & parameter, int step, int stepFast)
 	{
-		auto tmpRef = parameter.get();
-		if (ImGui::InputInt(GetUniqueName(parameter), &tmpRef, step, stepFast))
-		{
-			parameter.set(tmpRef);
-			return true;
-		}
-		return false;
+		auto tmpRef = Gui::GetEditValue(parameter);
+		const auto changed = ImGui::InputInt(GetUniqueName(parameter), &tmpRef, step, stepFast);
+		return Gui::CommitValue(parameter, tmpRef, changed);
 	}
 
 	//--------------------------------------------------------------
 	bool Gui::AddRange(const string & name, ofParameter<float> & parameterMin, ofParameter<float> & parameterMax, float speed)
 	{
-		auto tmpRefMin = parameterMin.get();
-		auto tmpRefMax = parameterMax.get();
-		if (ImGui::DragFloatRange2(GetUniqueName(name), &tmpRefMin, &tmpRefMax, speed, parameterMin.getMin(), parameterMax.getMax()))
+		auto tmpRefMin = Gui::GetEditValue(parameterMin);
+		auto tmpRefMax = Gui::GetEditValue(parameterMax);
+		const auto changed = ImGui::DragFloatRange2(GetUniqueName(name), &tmpRefMin, &tmpRefMax, speed, parameterMin.getMin(), parameterMax.getMax());
+
+		// Both parameters follow the state of the whole widget.
+		auto result = Gui::CommitValue(parameterMin, tmpRefMin, changed);
+		result |= Gui::CommitValue(parameterMax, tmpRefMax, changed);
+		return result;
+	}
+
+	//--------------------------------------------------------------
+	bool Gui::AddModulator(Modulator & modulator, Settings & settings)
+	{
+		if (!Gui::BeginTree(modulator, settings))
+		{
+			return false;
+		}
+
+		auto result = Gui::AddParameter(modulator.enabled);
+		result |= Gui::AddRadio(modulator.shape, Modulator::GetShapeNames(), 4);
+		if (modulator.shape == Modulator::Envelope)
 		{
-			parameterMin.set(tmpRefMin);
-			parameterMax.set(tmpRefMax);
-			return true;
+			result |= Gui::AddParameter(modulator.attack);
+			result |= Gui::AddParameter(modulator.release);
+			if (ImGui::Button(GetUniqueName("Trigger")))
+			{
+				modulator.trigger();
+			}
 		}
-		return false;
+		else
+		{
+			result |= Gui::AddParameter(modulator.frequency);
+			if (modulator.shape != Modulator::RandomWalk)
+			{
+				result |= Gui::AddParameter(modulator.phase);
+			}
+		}
+		result |= Gui::AddParameter(modulator.depth);
+
+		Gui::EndTree(settings);
+		return result;
 	}
 
 	//--------------------------------------------------------------
@@ -612,6 +877,153 @@ namespace ofxPreset
 		return result;
 	}
 
+	//--------------------------------------------------------------
+	void Gui::AddSearchNode(SearchIndex & index, int node, Settings & settings)
+	{
+		const auto & searchNode = index[node];
+		if (!searchNode.isGroup)
+		{
+			Gui::AddParameter(searchNode.parameter);
+			return;
+		}
+
+		// Only submit the children that match, or lead to a match.
+		if (Gui::BeginTree(*searchNode.parameter, settings))
+		{
+			for (auto child : searchNode.children)
+			{
+				if (index.isVisible(child))
+				{
+					Gui::AddSearchNode(index, child, settings);
+				}
+			}
+			Gui::EndTree(settings);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Gui::AddProfiler(Profiler & profiler, Settings & settings)
+	{
+		if (!settings.windowBlock)
+		{
+			ofLogWarning(__FUNCTION__) << "Not inside a window block!";
+			return;
+		}
+
+		auto enabled = profiler.isEnabled();
+		if (ImGui::Checkbox(GetUniqueName("Enabled"), &enabled))
+		{
+			profiler.setEnabled(enabled);
+		}
+		ImGui::SameLine();
+		if (ImGui::Button(GetUniqueName("Reset")))
+		{
+			profiler.reset();
+		}
+		ImGui::Text("Total: %.3f ms", profiler.getTotalTime() * 1000.0);
+
+		ImGui::Columns(4);
+		ImGui::Text("Parameter");
+		ImGui::NextColumn();
+		ImGui::Text("Count");
+		ImGui::NextColumn();
+		ImGui::Text("Total (ms)");
+		ImGui::NextColumn();
+		ImGui::Text("Max (ms)");
+		ImGui::NextColumn();
+		ImGui::Separator();
+		for (auto index : profiler.getSortedIndices())
+		{
+			const auto & entry = profiler[index];
+			ImGui::Text("%s", entry.path.c_str());
+			ImGui::NextColumn();
+			ImGui::Text("%zu", entry.count);
+			ImGui::NextColumn();
+			ImGui::Text("%.3f", entry.totalTime * 1000.0);
+			ImGui::NextColumn();
+			ImGui::Text("%.3f", entry.maxTime * 1000.0);
+			ImGui::NextColumn();
+		}
+		ImGui::Columns(1);
+	}
+
+	//--------------------------------------------------------------
+	void Gui::AddExpressions(Expressions & expressions, Settings & settings)
+	{
+		if (!settings.windowBlock)
+		{
+			ofLogWarning(__FUNCTION__) << "Not inside a window block!";
+			return;
+		}
+
+		for (size_t i = 0; i < expressions.size(); ++i)
+		{
+			// Copy the target, editing may remove the expression.
+			const auto target = expressions.getTarget(i);
+
+			char buffer[512];
+			strncpy(buffer, expressions.getExpression(i).c_str(), sizeof(buffer) - 1);
+			buffer[sizeof(buffer) - 1] = '\0';
+			if (ImGui::InputText(GetUniqueName(target), buffer, sizeof(buffer), ImGuiInputTextFlags_EnterReturnsTrue))
+			{
+				if (buffer[0] == '\0')
+				{
+					expressions.remove(target);
+					--i;
+				}
+				else
+				{
+					expressions.set(target, buffer);
+				}
+			}
+		}
+
+		auto & context = GetContext();
+		ImGui::InputText(GetUniqueName("Target"), context.newTarget, sizeof(context.newTarget));
+		ImGui::InputText(GetUniqueName("Expression"), context.newExpression, sizeof(context.newExpression));
+		if (ImGui::Button(GetUniqueName("Link")) && expressions.set(context.newTarget, context.newExpression))
+		{
+			context.newTarget[0] = '\0';
+			context.newExpression[0] = '\0';
+		}
+
+		if (!expressions.getError().empty())
+		{
+			ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", expressions.getError().c_str());
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool Gui::AddHistory(const History & history, const ofAbstractParameter & parameter, const ofVec2f & size)
+	{
+		const auto track = history.getTrack(parameter);
+		if (!track)
+		{
+			ofLogWarning(__FUNCTION__) << "Parameter " << parameter.getName() << " is not recorded";
+			return false;
+		}
+
+		float minValues[Binding::kMaxComponents];
+		float maxValues[Binding::kMaxComponents];
+		float values[Binding::kMaxComponents];
+		track->binding.getRange(minValues, maxValues);
+		const auto count = track->binding.getComponents(values);
+
+		// Read straight from the ring buffer, ImGui wraps around the offset.
+		const auto numValues = static_cast<int>(history.getNumValues(*track));
+		const auto offset = static_cast<int>(history.getOffset(*track));
+		for (size_t i = 0; i < count; ++i)
+		{
+			const auto label = (count == 1) ? parameter.getName() : parameter.getName() + " " + ofToString(i);
+			const auto overlay = ofToString(values[i], 3);
+			// Unranged parameters scale to the recorded values (FLT_MAX).
+			const auto scaleMin = std::isfinite(minValues[i]) ? minValues[i] : std::numeric_limits<float>::max();
+			const auto scaleMax = std::isfinite(maxValues[i]) ? maxValues[i] : std::numeric_limits<float>::max();
+			ImGui::PlotLines(GetUniqueName(label), history.getValues(*track, i), numValues, offset, overlay.c_str(), scaleMin, scaleMax, size);
+		}
+		return true;
+	}
+
 	//--------------------------------------------------------------
 	void Gui::AddImage(ofBaseHasTexture & hasTexture, const ofVec2f & size)
 	{
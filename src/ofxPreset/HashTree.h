@@ -0,0 +1,70 @@
+#pragma once
+
+#include "ofJson.h"
+#include "ofParameter.h"
+
+#include "Bindings.h"
+#include "Modulation.h"
+
+namespace ofxPreset
+{
+	// Merkle tree over the serializable parameters of a group.
+	// Leaves hash their typed value, groups hash their children. Changes only dirty
+	// the path from the changed leaf to the root, and hashes are refreshed lazily,
+	// so comparing against a snapshot costs O(changed) instead of O(all).
+	class HashTree
+	{
+	public:
+		// Hash of every node, in the same order as the tree.
+		typedef vector<uint64_t> Snapshot;
+
+		inline HashTree();
+
+		inline void setup(ofParameterGroup & group);
+		inline void clear();
+
+		inline uint64_t getHash();
+		inline uint64_t getHash(const string & path);
+
+		inline Snapshot getSnapshot();
+
+		// Hashes a saved preset without applying it.
+		inline Snapshot getSnapshot(const nlohmann::json & json);
+
+		inline bool equals(const Snapshot & snapshot);
+
+		// Paths of the parameters that differ from the snapshot, only visiting changed subtrees.
+		inline vector<string> getChangedPaths(const Snapshot & snapshot);
+
+	protected:
+		struct Node
+		{
+			string name;
+			string path;
+			int parent;
+			int binding;
+			vector<size_t> children;
+			uint64_t hash;
+			bool dirty;
+		};
+
+		static inline uint64_t HashLeaf(const string & name, const Binding & binding);
+		static inline uint64_t HashLeaf(const string & name, const Binding & binding, const string & valueString);
+		static inline uint64_t HashGroup(const string & name, const vector<size_t> & children, const vector<uint64_t> & hashes);
+
+		inline size_t addGroup(ofParameterGroup & group, const string & prefix, int parent);
+		inline void markDirty(size_t index);
+		inline void refresh(size_t index);
+		inline void hashJson(const nlohmann::json & json, size_t index, Snapshot & snapshot) const;
+		inline void diff(size_t index, const Snapshot & snapshot, vector<string> & paths) const;
+
+		Bindings bindings;
+		ofEventListener listener;
+
+		vector<Node> nodes;
+		vector<int> leafByBinding;
+		unordered_map<string, size_t> nodeByPath;
+	};
+}
+
+#include "HashTree.inl"
@@ -0,0 +1,317 @@
+#include "HashTree.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	uint64_t HashTree::HashLeaf(const string & name, const Binding & binding)
+	{
+		if (binding.isNumeric())
+		{
+			// Modulated parameters hash their base value, which is what gets saved.
+			float values[Binding::kMaxComponents];
+			const auto count = binding.getNumComponents();
+			if (!Modulation::GetBase(binding, values))
+			{
+				binding.getComponents(values);
+			}
+			for (size_t i = 0; i < count; ++i)
+			{
+				// Make sure -0 and 0 hash the same, as they compare equal.
+				values[i] = (values[i] == 0.0f) ? 0.0f : values[i];
+			}
+			return Bindings::Hash(values, count * sizeof(float), Bindings::Hash(name));
+		}
+		return Bindings::Hash(binding.parameter->toString(), Bindings::Hash(name));
+	}
+
+	//--------------------------------------------------------------
+	uint64_t HashTree::HashLeaf(const string & name, const Binding & binding, const string & valueString)
+	{
+		if (binding.isNumeric())
+		{
+			float values[Binding::kMaxComponents];
+			const auto count = binding.getNumComponents();
+			if (Binding::ParseComponents(valueString, values, count))
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					values[i] = (values[i] == 0.0f) ? 0.0f : values[i];
+				}
+				return Bindings::Hash(values, count * sizeof(float), Bindings::Hash(name));
+			}
+		}
+		return Bindings::Hash(valueString, Bindings::Hash(name));
+	}
+
+	//--------------------------------------------------------------
+	uint64_t HashTree::HashGroup(const string & name, const vector<size_t> & children, const vector<uint64_t> & hashes)
+	{
+		auto hash = Bindings::Hash(name);
+		for (auto child : children)
+		{
+			hash = Bindings::Hash(&hashes[child], sizeof(uint64_t), hash);
+		}
+		return hash;
+	}
+
+	//--------------------------------------------------------------
+	HashTree::HashTree()
+	{}
+
+	//--------------------------------------------------------------
+	void HashTree::setup(ofParameterGroup & group)
+	{
+		this->clear();
+
+		this->bindings.setup(group);
+		this->leafByBinding.assign(this->bindings.size(), -1);
+		this->addGroup(this->bindings.getGroup(), "", -1);
+
+		this->listener = this->bindings.getGroup().parameterChangedE().newListener([this](ofAbstractParameter & parameter)
+		{
+			const auto index = this->bindings.indexOf(parameter);
+			if (index >= 0 && this->leafByBinding[index] >= 0)
+			{
+				this->markDirty(this->leafByBinding[index]);
+			}
+		});
+	}
+
+	//--------------------------------------------------------------
+	void HashTree::clear()
+	{
+		this->listener.unsubscribe();
+		this->bindings.clear();
+		this->nodes.clear();
+		this->leafByBinding.clear();
+		this->nodeByPath.clear();
+	}
+
+	//--------------------------------------------------------------
+	uint64_t HashTree::getHash()
+	{
+		if (this->nodes.empty())
+		{
+			return 0;
+		}
+
+		this->refresh(0);
+		return this->nodes[0].hash;
+	}
+
+	//--------------------------------------------------------------
+	uint64_t HashTree::getHash(const string & path)
+	{
+		const auto it = this->nodeByPath.find(path);
+		if (it == this->nodeByPath.end())
+		{
+			ofLogWarning(__FUNCTION__) << "Path " << path << " not found!";
+			return 0;
+		}
+
+		this->refresh(it->second);
+		return this->nodes[it->second].hash;
+	}
+
+	//--------------------------------------------------------------
+	HashTree::Snapshot HashTree::getSnapshot()
+	{
+		Snapshot snapshot(this->nodes.size());
+		if (!this->nodes.empty())
+		{
+			this->refresh(0);
+		}
+		for (size_t i = 0; i < this->nodes.size(); ++i)
+		{
+			snapshot[i] = this->nodes[i].hash;
+		}
+		return snapshot;
+	}
+
+	//--------------------------------------------------------------
+	HashTree::Snapshot HashTree::getSnapshot(const nlohmann::json & json)
+	{
+		// Missing values hash to 0, which never matches a live value.
+		Snapshot snapshot(this->nodes.size(), 0);
+		if (!this->nodes.empty())
+		{
+			this->hashJson(json, 0, snapshot);
+		}
+		return snapshot;
+	}
+
+	//--------------------------------------------------------------
+	bool HashTree::equals(const Snapshot & snapshot)
+	{
+		return snapshot.size() == this->nodes.size() && !snapshot.empty() && this->getHash() == snapshot[0];
+	}
+
+	//--------------------------------------------------------------
+	vector<string> HashTree::getChangedPaths(const Snapshot & snapshot)
+	{
+		vector<string> paths;
+		if (snapshot.size() != this->nodes.size())
+		{
+			ofLogWarning(__FUNCTION__) << "Snapshot does not match the tree!";
+			return paths;
+		}
+		if (!this->nodes.empty())
+		{
+			this->refresh(0);
+			this->diff(0, snapshot, paths);
+		}
+		return paths;
+	}
+
+	//--------------------------------------------------------------
+	size_t HashTree::addGroup(ofParameterGroup & group, const string & prefix, int parent)
+	{
+		const auto index = this->nodes.size();
+		const auto path = group.getName().empty() ? prefix : prefix + "/" + group.getName();
+		{
+			Node node;
+			node.name = group.getName();
+			node.path = path;
+			node.parent = parent;
+			node.binding = -1;
+			node.hash = 0;
+			node.dirty = true;
+			this->nodes.push_back(node);
+		}
+		this->nodeByPath[path.empty() ? "/" : path] = index;
+
+		for (const auto & parameter : group)
+		{
+			if (!parameter || !parameter->isSerializable())
+			{
+				continue;
+			}
+
+			// Group.
+			auto parameterGroup = dynamic_pointer_cast<ofParameterGroup>(parameter);
+			if (parameterGroup)
+			{
+				// Recurse through contents.
+				const auto child = this->addGroup(*parameterGroup, path, index);
+				this->nodes[index].children.push_back(child);
+				continue;
+			}
+
+			// Parameter.
+			const auto binding = this->bindings.indexOf(*parameter);
+			if (binding < 0)
+			{
+				continue;
+			}
+
+			const auto child = this->nodes.size();
+			Node node;
+			node.name = parameter->getName();
+			node.path = this->bindings[binding].path;
+			node.parent = index;
+			node.binding = binding;
+			node.hash = 0;
+			node.dirty = true;
+			this->nodes.push_back(node);
+			this->nodes[index].children.push_back(child);
+			this->nodeByPath[node.path] = child;
+			this->leafByBinding[binding] = child;
+		}
+
+		return index;
+	}
+
+	//--------------------------------------------------------------
+	void HashTree::markDirty(size_t index)
+	{
+		// Stop as soon as we reach a node that is already dirty, its ancestors are too.
+		int current = index;
+		while (current >= 0 && !this->nodes[current].dirty)
+		{
+			this->nodes[current].dirty = true;
+			current = this->nodes[current].parent;
+		}
+	}
+
+	//--------------------------------------------------------------
+	void HashTree::refresh(size_t index)
+	{
+		auto & node = this->nodes[index];
+		if (!node.dirty)
+		{
+			return;
+		}
+
+		if (node.binding >= 0)
+		{
+			node.hash = HashLeaf(node.name, this->bindings[node.binding]);
+		}
+		else
+		{
+			// Same as HashGroup(), reading the hashes straight from the nodes.
+			node.hash = Bindings::Hash(node.name);
+			for (auto child : node.children)
+			{
+				this->refresh(child);
+				node.hash = Bindings::Hash(&this->nodes[child].hash, sizeof(uint64_t), node.hash);
+			}
+		}
+		node.dirty = false;
+	}
+
+	//--------------------------------------------------------------
+	void HashTree::hashJson(const nlohmann::json & json, size_t index, Snapshot & snapshot) const
+	{
+		const auto & node = this->nodes[index];
+		if (node.binding >= 0)
+		{
+			const auto it = json.find(node.name);
+			if (it != json.end() && it->is_string())
+			{
+				snapshot[index] = HashLeaf(node.name, this->bindings[node.binding], it->get_ref<const string &>());
+			}
+			return;
+		}
+
+		if (node.name.empty())
+		{
+			for (auto child : node.children)
+			{
+				this->hashJson(json, child, snapshot);
+			}
+		}
+		else
+		{
+			const auto it = json.find(node.name);
+			if (it != json.end())
+			{
+				for (auto child : node.children)
+				{
+					this->hashJson(*it, child, snapshot);
+				}
+			}
+		}
+		snapshot[index] = HashGroup(node.name, node.children, snapshot);
+	}
+
+	//--------------------------------------------------------------
+	void HashTree::diff(size_t index, const Snapshot & snapshot, vector<string> & paths) const
+	{
+		const auto & node = this->nodes[index];
+		if (node.hash == snapshot[index])
+		{
+			return;
+		}
+
+		if (node.binding >= 0)
+		{
+			paths.push_back(node.path);
+			return;
+		}
+
+		for (auto child : node.children)
+		{
+			this->diff(child, snapshot, paths);
+		}
+	}
+}
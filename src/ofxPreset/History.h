@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ofParameter.h"
+
+#include "Bindings.h"
+
+namespace ofxPreset
+{
+	// Records the values of numeric parameters over time, one sample per update().
+	// Every component gets a fixed-size ring buffer, allocated when the parameter is added.
+	class History
+	{
+	public:
+		static const size_t kDefaultLength = 256;
+
+		struct Track
+		{
+			Binding binding;
+			size_t length;
+			size_t count;
+			size_t head;
+			size_t offset;
+		};
+
+		inline History();
+
+		// Returns false if the parameter is not numeric.
+		inline bool add(ofAbstractParameter & parameter, size_t length = kDefaultLength);
+		inline bool remove(const ofAbstractParameter & parameter);
+		inline void clear();
+
+		inline size_t size() const;
+		inline bool empty() const;
+
+		// Samples every tracked parameter.
+		inline void update();
+
+		// Forgets the recorded samples, keeping the tracks.
+		inline void reset();
+
+		inline const Track * getTrack(const ofAbstractParameter & parameter) const;
+
+		// Samples of a component, the oldest one is at getOffset() once the buffer is full.
+		inline const float * getValues(const Track & track, size_t component) const;
+		inline size_t getNumValues(const Track & track) const;
+		inline size_t getOffset(const Track & track) const;
+
+	protected:
+		vector<Track> tracks;
+		vector<float> samples;
+		unordered_map<const void *, size_t> indexByIdentity;
+	};
+}
+
+#include "History.inl"
@@ -0,0 +1,134 @@
+#include "History.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	History::History()
+	{}
+
+	//--------------------------------------------------------------
+	bool History::add(ofAbstractParameter & parameter, size_t length)
+	{
+		const auto type = Binding::GetType(parameter);
+		if (Binding::GetNumComponents(type) == 0 || length == 0)
+		{
+			ofLogWarning(__FUNCTION__) << "Parameter " << parameter.getName() << " cannot be recorded";
+			return false;
+		}
+
+		this->remove(parameter);
+
+		Track track{ Binding(parameter.newReference(), parameter.getName()) };
+		track.length = length;
+		track.count = 0;
+		track.head = 0;
+		track.offset = this->samples.size();
+		this->samples.resize(this->samples.size() + length * track.binding.getNumComponents(), 0.0f);
+
+		this->indexByIdentity[track.binding.identity] = this->tracks.size();
+		this->tracks.push_back(track);
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	bool History::remove(const ofAbstractParameter & parameter)
+	{
+		const auto it = this->indexByIdentity.find(Binding::GetIdentity(parameter, Binding::GetType(parameter)));
+		if (it == this->indexByIdentity.end())
+		{
+			return false;
+		}
+
+		const auto index = it->second;
+		const auto offset = this->tracks[index].offset;
+		const auto numSamples = this->tracks[index].length * this->tracks[index].binding.getNumComponents();
+		this->samples.erase(this->samples.begin() + offset, this->samples.begin() + offset + numSamples);
+		this->tracks.erase(this->tracks.begin() + index);
+
+		// Shift everything after it.
+		this->indexByIdentity.clear();
+		for (size_t i = 0; i < this->tracks.size(); ++i)
+		{
+			if (i >= index)
+			{
+				this->tracks[i].offset -= numSamples;
+			}
+			this->indexByIdentity[this->tracks[i].binding.identity] = i;
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	void History::clear()
+	{
+		this->tracks.clear();
+		this->samples.clear();
+		this->indexByIdentity.clear();
+	}
+
+	//--------------------------------------------------------------
+	size_t History::size() const
+	{
+		return this->tracks.size();
+	}
+
+	//--------------------------------------------------------------
+	bool History::empty() const
+	{
+		return this->tracks.empty();
+	}
+
+	//--------------------------------------------------------------
+	void History::update()
+	{
+		float values[Binding::kMaxComponents];
+		for (auto & track : this->tracks)
+		{
+			const auto count = track.binding.getComponents(values);
+			auto data = this->samples.data() + track.offset + track.head;
+			for (size_t i = 0; i < count; ++i)
+			{
+				data[i * track.length] = values[i];
+			}
+
+			track.head = (track.head + 1) % track.length;
+			track.count = std::min(track.count + 1, track.length);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void History::reset()
+	{
+		for (auto & track : this->tracks)
+		{
+			track.count = 0;
+			track.head = 0;
+		}
+	}
+
+	//--------------------------------------------------------------
+	const History::Track * History::getTrack(const ofAbstractParameter & parameter) const
+	{
+		const auto it = this->indexByIdentity.find(Binding::GetIdentity(parameter, Binding::GetType(parameter)));
+		return (it == this->indexByIdentity.end()) ? nullptr : &this->tracks[it->second];
+	}
+
+	//--------------------------------------------------------------
+	const float * History::getValues(const Track & track, size_t component) const
+	{
+		return this->samples.data() + track.offset + component * track.length;
+	}
+
+	//--------------------------------------------------------------
+	size_t History::getNumValues(const Track & track) const
+	{
+		return track.count;
+	}
+
+	//--------------------------------------------------------------
+	size_t History::getOffset(const Track & track) const
+	{
+		// Until the buffer wraps, the oldest sample is the first one.
+		return (track.count < track.length) ? 0 : track.head;
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ofParameter.h"
+#include "ofThread.h"
+#include "ofThreadChannel.h"
+
+#include "Serializer.h"
+
+namespace ofxPreset
+{
+	// Append-only log of every change to a group, for crash recovery.
+	// Changes are buffered as timestamped binary records and written and synced to disk in batches on a worker thread.
+	// The log is periodically compacted into a JSON snapshot, and replayed on top of it when set up again.
+	class Journal
+		: public ofThread
+	{
+	public:
+		static const uint32_t kMagic = 0x4a50464f; // "OFPJ"
+		static const size_t kHeaderSize = sizeof(uint32_t) + sizeof(uint64_t);
+
+		inline Journal();
+		inline ~Journal();
+
+		// Uses basePath + ".json" for the snapshot and basePath + ".journal" for the changes since.
+		// Recovers the state saved there, if any, then starts a new journal.
+		inline bool setup(ofParameterGroup & group, const string & basePath);
+
+		// Stops journaling after writing everything pending.
+		inline void close();
+
+		// Stops journaling and deletes the files, e.g. on a clean exit.
+		inline void discard();
+
+		// Call once per frame, hands the pending records to the writer and compacts when needed.
+		inline void update();
+
+		// Writes a snapshot of the current values and starts a new journal.
+		inline void compact();
+
+		inline void setFlushInterval(float seconds);
+		inline void setCompactSize(size_t numBytes);
+
+		// Number of changes replayed by the last setup().
+		inline size_t getNumRecovered() const;
+
+	protected:
+		struct Command
+		{
+			vector<char> records;
+			string snapshot;
+			bool discard;
+			bool stop;
+		};
+
+		static inline void Sync(FILE * file);
+
+		inline size_t replay(Transaction & transaction);
+		inline void writeRecord(size_t index);
+		inline void send(Command & command);
+
+		inline void threadedFunction() override;
+		inline void writeSnapshot(const string & snapshot);
+
+		Bindings bindings;
+		ofEventListener listener;
+		string snapshotPath;
+		string journalPath;
+
+		// Main thread.
+		vector<char> buffer;
+		unique_ptr<ofThreadChannel<Command>> commands;
+		float flushInterval;
+		float lastFlushTime;
+		size_t compactSize;
+		size_t journalSize;
+		size_t numRecovered;
+
+		// Writer thread.
+		FILE * file;
+	};
+}
+
+#include "Journal.inl"
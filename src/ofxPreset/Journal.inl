@@ -0,0 +1,439 @@
+#include "Journal.h"
+
+#include <chrono>
+
+#ifdef TARGET_WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	void Journal::Sync(FILE * file)
+	{
+		fflush(file);
+#ifdef TARGET_WIN32
+		_commit(_fileno(file));
+#else
+		fsync(fileno(file));
+#endif
+	}
+
+	//--------------------------------------------------------------
+	Journal::Journal()
+		: flushInterval(0.5f)
+		, lastFlushTime(0.0f)
+		, compactSize(1024 * 1024)
+		, journalSize(0)
+		, numRecovered(0)
+		, file(nullptr)
+	{}
+
+	//--------------------------------------------------------------
+	Journal::~Journal()
+	{
+		this->close();
+	}
+
+	//--------------------------------------------------------------
+	bool Journal::setup(ofParameterGroup & group, const string & basePath)
+	{
+		this->close();
+
+		this->bindings.setup(group);
+		if (this->bindings.size() > std::numeric_limits<uint16_t>::max())
+		{
+			ofLogError(__FUNCTION__) << "Group " << group.getName() << " has too many parameters to journal";
+			return false;
+		}
+
+		this->snapshotPath = ofToDataPath(basePath + ".json", true);
+		this->journalPath = ofToDataPath(basePath + ".journal", true);
+
+		// Restore the last snapshot and every change since, notifying everything once at the end.
+		{
+			Transaction transaction(this->bindings.getGroup());
+
+			ofFile snapshotFile(this->snapshotPath);
+			if (snapshotFile.exists())
+			{
+				try
+				{
+					nlohmann::json json;
+					snapshotFile >> json;
+					Serializer::Deserialize(json, this->bindings.getGroup(), transaction);
+				}
+				catch (const std::exception & e)
+				{
+					ofLogError(__FUNCTION__) << "Could not read snapshot " << this->snapshotPath << ": " << e.what();
+				}
+			}
+
+			this->numRecovered = this->replay(transaction);
+			transaction.commit();
+		}
+		if (this->numRecovered)
+		{
+			ofLogNotice(__FUNCTION__) << "Recovered " << this->numRecovered << " changes from " << this->journalPath;
+		}
+
+		// Only record from here on, so the replay is not journaled again.
+		this->listener = this->bindings.getGroup().parameterChangedE().newListener([this](ofAbstractParameter & parameter)
+		{
+			const auto index = this->bindings.indexOf(parameter);
+			if (index >= 0 && this->bindings[index].parameter->isSerializable())
+			{
+				// Modulated values change every frame, only their base value is journaled.
+				float values[Binding::kMaxComponents];
+				if (Modulation::GetBase(this->bindings[index], values))
+				{
+					return;
+				}
+				this->writeRecord(index);
+			}
+		});
+
+		this->commands.reset(new ofThreadChannel<Command>());
+		this->startThread();
+
+		// Fold the recovered state into a fresh snapshot and start a new journal.
+		this->compact();
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	void Journal::close()
+	{
+		if (!this->commands)
+		{
+			return;
+		}
+
+		this->listener.unsubscribe();
+
+		// Write what is left before stopping, closing the channel right away would drop pending commands.
+		Command command{};
+		command.stop = true;
+		this->send(command);
+		this->waitForThread(false);
+
+		this->commands->close();
+		this->waitForThread(true);
+		this->commands.reset();
+	}
+
+	//--------------------------------------------------------------
+	void Journal::discard()
+	{
+		if (!this->commands)
+		{
+			return;
+		}
+
+		this->listener.unsubscribe();
+		this->buffer.clear();
+
+		Command command{};
+		command.discard = true;
+		this->send(command);
+
+		this->close();
+	}
+
+	//--------------------------------------------------------------
+	void Journal::update()
+	{
+		if (!this->commands)
+		{
+			return;
+		}
+
+		if (this->journalSize >= this->compactSize)
+		{
+			this->compact();
+			return;
+		}
+
+		const auto now = ofGetElapsedTimef();
+		if (!this->buffer.empty() && now - this->lastFlushTime >= this->flushInterval)
+		{
+			Command command{};
+			this->send(command);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Journal::compact()
+	{
+		if (!this->commands)
+		{
+			ofLogWarning(__FUNCTION__) << "Journal is not set up!";
+			return;
+		}
+
+		nlohmann::json json;
+		Serializer::Serialize(json, this->bindings.getGroup());
+
+		// Pending records go to the old journal first, so it is always safe to replay it on top of the new snapshot.
+		Command command{};
+		command.snapshot = json.dump(4);
+		this->send(command);
+
+		this->journalSize = 0;
+	}
+
+	//--------------------------------------------------------------
+	void Journal::setFlushInterval(float seconds)
+	{
+		this->flushInterval = seconds;
+	}
+
+	//--------------------------------------------------------------
+	void Journal::setCompactSize(size_t numBytes)
+	{
+		this->compactSize = numBytes;
+	}
+
+	//--------------------------------------------------------------
+	size_t Journal::getNumRecovered() const
+	{
+		return this->numRecovered;
+	}
+
+	//--------------------------------------------------------------
+	size_t Journal::replay(Transaction & transaction)
+	{
+		auto journalFile = fopen(this->journalPath.c_str(), "rb");
+		if (!journalFile)
+		{
+			return 0;
+		}
+
+		uint32_t magic = 0;
+		uint64_t schemaHash = 0;
+		if (fread(&magic, sizeof(magic), 1, journalFile) != 1 || fread(&schemaHash, sizeof(schemaHash), 1, journalFile) != 1 || magic != kMagic)
+		{
+			ofLogWarning(__FUNCTION__) << "Journal " << this->journalPath << " is not valid, ignoring it";
+			fclose(journalFile);
+			return 0;
+		}
+		if (schemaHash != this->bindings.getSchemaHash())
+		{
+			ofLogWarning(__FUNCTION__) << "Journal " << this->journalPath << " was written for a different group layout, ignoring it";
+			fclose(journalFile);
+			return 0;
+		}
+
+		// Stop at the first incomplete record, which is where the last write was interrupted.
+		size_t numRecords = 0;
+		string valueString;
+		while (true)
+		{
+			uint64_t timestamp;
+			uint16_t index;
+			if (fread(&timestamp, sizeof(timestamp), 1, journalFile) != 1 || fread(&index, sizeof(index), 1, journalFile) != 1)
+			{
+				break;
+			}
+			if (index >= this->bindings.size())
+			{
+				ofLogWarning(__FUNCTION__) << "Journal " << this->journalPath << " is corrupted after " << numRecords << " records";
+				break;
+			}
+
+			const auto & binding = this->bindings[index];
+			if (binding.isNumeric())
+			{
+				float values[Binding::kMaxComponents];
+				const auto count = binding.getNumComponents();
+				if (fread(values, sizeof(float), count, journalFile) != count)
+				{
+					break;
+				}
+				transaction.set(*binding.parameter, binding.type, values);
+			}
+			else
+			{
+				uint16_t length;
+				if (fread(&length, sizeof(length), 1, journalFile) != 1)
+				{
+					break;
+				}
+				valueString.resize(length);
+				if (length && fread(&valueString[0], 1, length, journalFile) != length)
+				{
+					break;
+				}
+				transaction.set(*binding.parameter, valueString);
+			}
+			++numRecords;
+		}
+
+		fclose(journalFile);
+		return numRecords;
+	}
+
+	//--------------------------------------------------------------
+	void Journal::writeRecord(size_t index)
+	{
+		const auto & binding = this->bindings[index];
+		const auto timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+		const auto index16 = static_cast<uint16_t>(index);
+
+		float values[Binding::kMaxComponents];
+		string valueString;
+		size_t payloadSize;
+		if (binding.isNumeric())
+		{
+			payloadSize = binding.getComponents(values) * sizeof(float);
+		}
+		else
+		{
+			valueString = binding.parameter->toString();
+			if (valueString.size() > std::numeric_limits<uint16_t>::max())
+			{
+				ofLogWarning(__FUNCTION__) << "Value of " << binding.path << " is truncated to " << std::numeric_limits<uint16_t>::max() << " characters";
+				valueString.resize(std::numeric_limits<uint16_t>::max());
+			}
+			payloadSize = sizeof(uint16_t) + valueString.size();
+		}
+
+		const auto offset = this->buffer.size();
+		const auto recordSize = sizeof(timestamp) + sizeof(index16) + payloadSize;
+		this->buffer.resize(offset + recordSize);
+		auto data = this->buffer.data() + offset;
+
+		memcpy(data, &timestamp, sizeof(timestamp));
+		data += sizeof(timestamp);
+		memcpy(data, &index16, sizeof(index16));
+		data += sizeof(index16);
+
+		if (binding.isNumeric())
+		{
+			memcpy(data, values, payloadSize);
+		}
+		else
+		{
+			const auto length = static_cast<uint16_t>(valueString.size());
+			memcpy(data, &length, sizeof(length));
+			memcpy(data + sizeof(length), valueString.data(), length);
+		}
+
+		this->journalSize += recordSize;
+	}
+
+	//--------------------------------------------------------------
+	void Journal::send(Command & command)
+	{
+		command.records.swap(this->buffer);
+		this->commands->send(std::move(command));
+		this->lastFlushTime = ofGetElapsedTimef();
+	}
+
+	//--------------------------------------------------------------
+	void Journal::threadedFunction()
+	{
+		Command command;
+		while (this->commands->receive(command))
+		{
+			if (command.discard)
+			{
+				if (this->file)
+				{
+					fclose(this->file);
+					this->file = nullptr;
+				}
+				std::remove(this->journalPath.c_str());
+				std::remove(this->snapshotPath.c_str());
+			}
+
+			if (this->file && !command.records.empty())
+			{
+				fwrite(command.records.data(), 1, command.records.size(), this->file);
+			}
+
+			if (!command.snapshot.empty())
+			{
+				this->writeSnapshot(command.snapshot);
+			}
+			else if (this->file)
+			{
+				Sync(this->file);
+			}
+
+			if (command.stop)
+			{
+				break;
+			}
+		}
+
+		if (this->file)
+		{
+			Sync(this->file);
+			fclose(this->file);
+			this->file = nullptr;
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Journal::writeSnapshot(const string & snapshot)
+	{
+		// Keep journaling to the current file until the snapshot is in place, so a failure loses nothing.
+		// Write to a temporary file first, so a crash never leaves a partial snapshot behind.
+		const auto tempPath = this->snapshotPath + ".tmp";
+		auto snapshotFile = fopen(tempPath.c_str(), "wb");
+		if (!snapshotFile)
+		{
+			ofLogError(__FUNCTION__) << "Could not write snapshot " << tempPath;
+			return;
+		}
+		const auto written = (fwrite(snapshot.data(), 1, snapshot.size(), snapshotFile) == snapshot.size());
+		Sync(snapshotFile);
+		if (fclose(snapshotFile) != 0 || !written)
+		{
+			ofLogError(__FUNCTION__) << "Could not write snapshot " << tempPath;
+			std::remove(tempPath.c_str());
+			return;
+		}
+
+#ifdef TARGET_WIN32
+		// Replace the previous snapshot in one step, removing it first would leave a window without any.
+		const auto renamed = (MoveFileExA(tempPath.c_str(), this->snapshotPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0);
+#else
+		const auto renamed = (std::rename(tempPath.c_str(), this->snapshotPath.c_str()) == 0);
+#endif
+		if (!renamed)
+		{
+			ofLogError(__FUNCTION__) << "Could not replace snapshot " << this->snapshotPath;
+			std::remove(tempPath.c_str());
+			return;
+		}
+
+		// Everything journaled so far is in the snapshot, start over.
+		// If the new journal cannot be opened, keep appending to the old one, replaying it over the new snapshot is harmless.
+		// Flush the old one first, truncating the file under it would otherwise get its buffered records written back.
+		if (this->file)
+		{
+			Sync(this->file);
+		}
+		auto journalFile = fopen(this->journalPath.c_str(), "wb");
+		if (!journalFile)
+		{
+			ofLogError(__FUNCTION__) << "Could not open journal " << this->journalPath;
+			return;
+		}
+		if (this->file)
+		{
+			fclose(this->file);
+		}
+		this->file = journalFile;
+
+		const auto magic = kMagic;
+		const auto schemaHash = this->bindings.getSchemaHash();
+		fwrite(&magic, sizeof(magic), 1, this->file);
+		fwrite(&schemaHash, sizeof(schemaHash), 1, this->file);
+		Sync(this->file);
+	}
+}
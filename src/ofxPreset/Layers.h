@@ -0,0 +1,72 @@
+#pragma once
+
+#include "ofJson.h"
+#include "ofParameter.h"
+
+#include "Bindings.h"
+#include "Transaction.h"
+
+namespace ofxPreset
+{
+	// Stack of presets applied on top of each other, e.g. a base show preset with venue and scene overrides.
+	// The layer providing each parameter is cached, and only the parameters set by a layer that changed
+	// are resolved and applied again, so toggling an override does not reapply the whole group.
+	class Layers
+	{
+	public:
+		inline Layers();
+
+		inline void setup(ofParameterGroup & group);
+		inline void clear();
+
+		// Later layers override earlier ones. The json has the same layout as Serializer::Serialize() output.
+		inline size_t add(const string & name, const nlohmann::json & json, bool enabled = true);
+		inline void remove(size_t index);
+
+		// Replaces all the values of a layer.
+		inline void set(size_t index, const nlohmann::json & json);
+
+		// Sets or removes a single value of a layer.
+		inline bool set(size_t index, const ofAbstractParameter & parameter, const string & valueString);
+		inline bool unset(size_t index, const ofAbstractParameter & parameter);
+
+		inline void setEnabled(size_t index, bool enabled);
+		inline bool isEnabled(size_t index) const;
+
+		inline size_t size() const;
+		inline bool empty() const;
+
+		inline const string & getName(size_t index) const;
+		inline int indexOf(const string & name) const;
+
+		// Index of the layer that provides the value of the parameter, or -1 if no enabled layer sets it.
+		inline int getSource(const ofAbstractParameter & parameter);
+
+		// Sets the parameters whose layers changed since the last call, and notifies them once all values are in place.
+		// Parameters that no enabled layer sets keep their current value. Returns the number of values resolved.
+		inline size_t apply();
+		inline size_t apply(Transaction & transaction);
+
+	protected:
+		struct Layer
+		{
+			string name;
+			bool enabled;
+			unordered_map<size_t, string> values;
+		};
+
+		inline void collect(const nlohmann::json & json, ofParameterGroup & group, Layer & layer);
+		inline void markDirty(const Layer & layer);
+		inline void markDirty(size_t binding);
+		inline void resolve();
+
+		Bindings bindings;
+		vector<Layer> layers;
+
+		vector<int> sources;
+		vector<uint8_t> dirty;
+		vector<size_t> dirtyBindings;
+	};
+}
+
+#include "Layers.inl"
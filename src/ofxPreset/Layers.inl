@@ -0,0 +1,321 @@
+#include "Layers.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	Layers::Layers()
+	{}
+
+	//--------------------------------------------------------------
+	void Layers::setup(ofParameterGroup & group)
+	{
+		this->clear();
+
+		this->bindings.setup(group);
+		this->sources.assign(this->bindings.size(), -1);
+		this->dirty.assign(this->bindings.size(), 0);
+	}
+
+	//--------------------------------------------------------------
+	void Layers::clear()
+	{
+		this->bindings.clear();
+		this->layers.clear();
+		this->sources.clear();
+		this->dirty.clear();
+		this->dirtyBindings.clear();
+	}
+
+	//--------------------------------------------------------------
+	size_t Layers::add(const string & name, const nlohmann::json & json, bool enabled)
+	{
+		Layer layer;
+		layer.name = name;
+		layer.enabled = enabled;
+		this->collect(json, this->bindings.getGroup(), layer);
+
+		if (layer.enabled)
+		{
+			this->markDirty(layer);
+		}
+		this->layers.push_back(std::move(layer));
+		return this->layers.size() - 1;
+	}
+
+	//--------------------------------------------------------------
+	void Layers::remove(size_t index)
+	{
+		if (index >= this->layers.size())
+		{
+			ofLogWarning(__FUNCTION__) << "Index " << index << " out of range!";
+			return;
+		}
+
+		if (this->layers[index].enabled)
+		{
+			this->markDirty(this->layers[index]);
+		}
+		this->layers.erase(this->layers.begin() + index);
+
+		// Shift the cached sources above it, the ones it provided are dirty.
+		for (auto & source : this->sources)
+		{
+			if (source > static_cast<int>(index))
+			{
+				--source;
+			}
+			else if (source == static_cast<int>(index))
+			{
+				source = -1;
+			}
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Layers::set(size_t index, const nlohmann::json & json)
+	{
+		if (index >= this->layers.size())
+		{
+			ofLogWarning(__FUNCTION__) << "Index " << index << " out of range!";
+			return;
+		}
+
+		// Both the old and the new values need resolving.
+		auto & layer = this->layers[index];
+		if (layer.enabled)
+		{
+			this->markDirty(layer);
+		}
+		layer.values.clear();
+		this->collect(json, this->bindings.getGroup(), layer);
+		if (layer.enabled)
+		{
+			this->markDirty(layer);
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool Layers::set(size_t index, const ofAbstractParameter & parameter, const string & valueString)
+	{
+		const auto binding = this->bindings.indexOf(parameter);
+		if (index >= this->layers.size() || binding < 0)
+		{
+			ofLogWarning(__FUNCTION__) << "Parameter " << parameter.getName() << " not found in layer " << index << "!";
+			return false;
+		}
+
+		this->layers[index].values[binding] = valueString;
+		if (this->layers[index].enabled)
+		{
+			this->markDirty(binding);
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	bool Layers::unset(size_t index, const ofAbstractParameter & parameter)
+	{
+		const auto binding = this->bindings.indexOf(parameter);
+		if (index >= this->layers.size() || binding < 0 || !this->layers[index].values.erase(binding))
+		{
+			return false;
+		}
+
+		if (this->layers[index].enabled)
+		{
+			this->markDirty(binding);
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	void Layers::setEnabled(size_t index, bool enabled)
+	{
+		if (index >= this->layers.size())
+		{
+			ofLogWarning(__FUNCTION__) << "Index " << index << " out of range!";
+			return;
+		}
+
+		auto & layer = this->layers[index];
+		if (layer.enabled != enabled)
+		{
+			layer.enabled = enabled;
+			this->markDirty(layer);
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool Layers::isEnabled(size_t index) const
+	{
+		return index < this->layers.size() && this->layers[index].enabled;
+	}
+
+	//--------------------------------------------------------------
+	size_t Layers::size() const
+	{
+		return this->layers.size();
+	}
+
+	//--------------------------------------------------------------
+	bool Layers::empty() const
+	{
+		return this->layers.empty();
+	}
+
+	//--------------------------------------------------------------
+	const string & Layers::getName(size_t index) const
+	{
+		return this->layers[index].name;
+	}
+
+	//--------------------------------------------------------------
+	int Layers::indexOf(const string & name) const
+	{
+		for (size_t i = 0; i < this->layers.size(); ++i)
+		{
+			if (this->layers[i].name == name)
+			{
+				return static_cast<int>(i);
+			}
+		}
+		return -1;
+	}
+
+	//--------------------------------------------------------------
+	int Layers::getSource(const ofAbstractParameter & parameter)
+	{
+		const auto binding = this->bindings.indexOf(parameter);
+		if (binding < 0)
+		{
+			return -1;
+		}
+
+		this->resolve();
+		return this->sources[binding];
+	}
+
+	//--------------------------------------------------------------
+	size_t Layers::apply()
+	{
+		Transaction transaction(this->bindings.getGroup());
+		const auto count = this->apply(transaction);
+		transaction.commit();
+		return count;
+	}
+
+	//--------------------------------------------------------------
+	size_t Layers::apply(Transaction & transaction)
+	{
+		const auto count = this->dirtyBindings.size();
+		for (auto binding : this->dirtyBindings)
+		{
+			// Same as resolve(), setting the values on the way.
+			this->dirty[binding] = 0;
+			this->sources[binding] = -1;
+			for (int i = static_cast<int>(this->layers.size()) - 1; i >= 0; --i)
+			{
+				const auto & layer = this->layers[i];
+				if (!layer.enabled)
+				{
+					continue;
+				}
+
+				const auto it = layer.values.find(binding);
+				if (it != layer.values.end())
+				{
+					this->sources[binding] = i;
+					transaction.set(*this->bindings[binding].parameter, it->second);
+					break;
+				}
+			}
+		}
+		this->dirtyBindings.clear();
+		return count;
+	}
+
+	//--------------------------------------------------------------
+	void Layers::collect(const nlohmann::json & json, ofParameterGroup & group, Layer & layer)
+	{
+		if (!group.isSerializable())
+		{
+			return;
+		}
+
+		// Same layout as Serializer::Deserialize(), unnamed groups are merged into their parent.
+		const auto name = group.getName();
+		const auto it = name.empty() ? json.end() : json.find(name);
+		if (!name.empty() && it == json.end())
+		{
+			return;
+		}
+
+		const auto & jsonGroup = name.empty() ? json : *it;
+		for (const auto & parameter : group)
+		{
+			if (!parameter)
+			{
+				continue;
+			}
+
+			// Group.
+			auto parameterGroup = dynamic_pointer_cast<ofParameterGroup>(parameter);
+			if (parameterGroup)
+			{
+				// Recurse through contents.
+				this->collect(jsonGroup, *parameterGroup, layer);
+				continue;
+			}
+
+			// Parameter.
+			const auto jsonValue = jsonGroup.find(parameter->getName());
+			if (jsonValue == jsonGroup.end() || !jsonValue->is_string() || !parameter->isSerializable())
+			{
+				continue;
+			}
+
+			const auto binding = this->bindings.indexOf(*parameter);
+			if (binding >= 0)
+			{
+				layer.values[binding] = jsonValue->get<string>();
+			}
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Layers::markDirty(const Layer & layer)
+	{
+		for (const auto & it : layer.values)
+		{
+			this->markDirty(it.first);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Layers::markDirty(size_t binding)
+	{
+		if (!this->dirty[binding])
+		{
+			this->dirty[binding] = 1;
+			this->dirtyBindings.push_back(binding);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Layers::resolve()
+	{
+		// Only updates the cached sources, the bindings stay dirty until they are applied.
+		for (auto binding : this->dirtyBindings)
+		{
+			this->sources[binding] = -1;
+			for (int i = static_cast<int>(this->layers.size()) - 1; i >= 0; --i)
+			{
+				if (this->layers[i].enabled && this->layers[i].values.count(binding))
+				{
+					this->sources[binding] = i;
+					break;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "ofEvents.h"
+#include "ofParameter.h"
+
+#include "Bindings.h"
+#include "Transaction.h"
+
+namespace ofxPreset
+{
+	// Settings of a modulation source, a parameter group so it can be serialized and edited like any other.
+	class Modulator
+		: public ofParameterGroup
+	{
+	public:
+		enum Shape
+		{
+			Sine = 0,
+			Triangle,
+			Saw,
+			Square,
+			Noise,
+			RandomWalk,
+			Envelope,
+			NumShapes
+		};
+
+		static inline const vector<string> & GetShapeNames();
+
+		inline Modulator(const string & name = "Modulator");
+
+		// Restarts the envelope of every target using this modulator.
+		inline void trigger();
+		inline uint32_t getTriggerCount() const;
+
+		ofParameter<bool> enabled{ "Enabled", true };
+		ofParameter<int> shape{ "Shape", Sine, Sine, NumShapes - 1 };
+		ofParameter<float> frequency{ "Frequency", 1.0f, 0.0f, 20.0f };
+		ofParameter<float> phase{ "Phase", 0.0f, 0.0f, 1.0f };
+		// Fraction of half the parameter's range, around its base value.
+		ofParameter<float> depth{ "Depth", 1.0f, 0.0f, 1.0f };
+		// Envelope only, in seconds.
+		ofParameter<float> attack{ "Attack", 0.1f, 0.0f, 10.0f };
+		ofParameter<float> release{ "Release", 1.0f, 0.0f, 10.0f };
+
+	protected:
+		uint32_t triggerCount;
+	};
+
+	// Drives numeric parameters (float, vector and color) from modulators, evaluated in one batch per update().
+	// Each update writes all the values in one transaction, so parameter listeners and the commit event of the
+	// group passed to setup() see the whole batch. The value a parameter is set to from anywhere else becomes
+	// its new base value, and the base value is what Serializer, Store, HashTree and Journal save.
+	class Modulation
+	{
+	public:
+		// Base value of a parameter that any modulation is driving.
+		// Returns false if it is not modulated or currently holds its base value, so its own value can be saved.
+		static inline bool GetBase(const ofAbstractParameter & parameter, float * values);
+		static inline bool GetBase(const Binding & binding, float * values);
+		// Value string of the parameter, with its base value if it is modulated.
+		static inline string GetBaseString(const ofAbstractParameter & parameter);
+
+		inline Modulation();
+		inline ~Modulation();
+
+		// The group holding the modulated parameters, for its commit event. Parameters are notified without it.
+		inline void setup(ofParameterGroup & group);
+
+		// The modulator must outlive the modulation. Returns false if the parameter is not numeric.
+		inline bool add(ofAbstractParameter & parameter, Modulator & modulator);
+		inline bool remove(const ofAbstractParameter & parameter);
+		inline void clear();
+
+		inline size_t size() const;
+		inline bool empty() const;
+
+		inline void update();
+		inline void update(float deltaTime);
+
+	protected:
+		static inline float Evaluate(int shape, float phase, float noiseOffset);
+
+		// Modulation driving each parameter, by value identity.
+		static inline unordered_map<const void *, Modulation *> & GetModulations();
+		static inline bool GetBase(const void * identity, float * values);
+
+		struct Target
+		{
+			Binding binding;
+			Modulator * modulator;
+			size_t offset;
+			size_t count;
+			float phase;
+			float walk;
+			float envelopeTime;
+			uint32_t triggerCount;
+		};
+
+		ofParameterGroup group;
+		vector<Target> targets;
+
+		// One lane per component of every target, laid out contiguously so the batch loop vectorizes.
+		vector<float> baseValues;
+		vector<float> lastValues;
+		vector<float> minValues;
+		vector<float> maxValues;
+		vector<float> amounts;
+		vector<float> outValues;
+	};
+}
+
+#include "Modulation.inl"
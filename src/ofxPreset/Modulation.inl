@@ -0,0 +1,348 @@
+#include "Modulation.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	const vector<string> & Modulator::GetShapeNames()
+	{
+		static const vector<string> names = { "Sine", "Triangle", "Saw", "Square", "Noise", "Random Walk", "Envelope" };
+		return names;
+	}
+
+	//--------------------------------------------------------------
+	Modulator::Modulator(const string & name)
+		: triggerCount(0)
+	{
+		this->setName(name);
+		this->add(this->enabled, this->shape, this->frequency, this->phase, this->depth, this->attack, this->release);
+	}
+
+	//--------------------------------------------------------------
+	void Modulator::trigger()
+	{
+		++this->triggerCount;
+	}
+
+	//--------------------------------------------------------------
+	uint32_t Modulator::getTriggerCount() const
+	{
+		return this->triggerCount;
+	}
+
+	//--------------------------------------------------------------
+	float Modulation::Evaluate(int shape, float phase, float noiseOffset)
+	{
+		const auto fraction = phase - floorf(phase);
+		switch (shape)
+		{
+		case Modulator::Sine:
+			return sinf(TWO_PI * phase);
+		case Modulator::Triangle:
+		{
+			const auto shifted = fraction + 0.25f;
+			return 1.0f - 4.0f * fabsf(shifted - floorf(shifted) - 0.5f);
+		}
+		case Modulator::Saw:
+		{
+			const auto shifted = fraction + 0.5f;
+			return 2.0f * (shifted - floorf(shifted)) - 1.0f;
+		}
+		case Modulator::Square:
+			return (fraction < 0.5f) ? 1.0f : -1.0f;
+		case Modulator::Noise:
+			return ofSignedNoise(phase, noiseOffset);
+		default:
+			return 0.0f;
+		}
+	}
+
+	//--------------------------------------------------------------
+	unordered_map<const void *, Modulation *> & Modulation::GetModulations()
+	{
+		static unordered_map<const void *, Modulation *> modulations;
+		return modulations;
+	}
+
+	//--------------------------------------------------------------
+	bool Modulation::GetBase(const void * identity, float * values)
+	{
+		const auto & modulations = GetModulations();
+		if (modulations.empty() || !identity)
+		{
+			return false;
+		}
+		const auto it = modulations.find(identity);
+		if (it == modulations.end())
+		{
+			return false;
+		}
+
+		for (const auto & target : it->second->targets)
+		{
+			if (target.binding.identity != identity)
+			{
+				continue;
+			}
+
+			// A value set from outside since the last update is the new base already.
+			float current[Binding::kMaxComponents];
+			target.binding.getComponents(current);
+			if (!std::equal(current, current + target.count, it->second->lastValues.begin() + target.offset))
+			{
+				return false;
+			}
+
+			const auto baseValues = it->second->baseValues.begin() + target.offset;
+			std::copy(baseValues, baseValues + target.count, values);
+			return !std::equal(current, current + target.count, values);
+		}
+		return false;
+	}
+
+	//--------------------------------------------------------------
+	bool Modulation::GetBase(const ofAbstractParameter & parameter, float * values)
+	{
+		if (GetModulations().empty())
+		{
+			return false;
+		}
+		return GetBase(Binding::GetIdentity(parameter, Binding::GetType(parameter)), values);
+	}
+
+	//--------------------------------------------------------------
+	bool Modulation::GetBase(const Binding & binding, float * values)
+	{
+		return GetBase(binding.identity, values);
+	}
+
+	//--------------------------------------------------------------
+	string Modulation::GetBaseString(const ofAbstractParameter & parameter)
+	{
+		float values[Binding::kMaxComponents];
+		if (GetBase(parameter, values))
+		{
+			return Binding::ToString(Binding::GetType(parameter), values);
+		}
+		return parameter.toString();
+	}
+
+	//--------------------------------------------------------------
+	Modulation::Modulation()
+	{}
+
+	//--------------------------------------------------------------
+	Modulation::~Modulation()
+	{
+		this->clear();
+	}
+
+	//--------------------------------------------------------------
+	void Modulation::setup(ofParameterGroup & group)
+	{
+		this->group = group;
+	}
+
+	//--------------------------------------------------------------
+	bool Modulation::add(ofAbstractParameter & parameter, Modulator & modulator)
+	{
+		const auto type = Binding::GetType(parameter);
+		if (Binding::GetNumComponents(type) == 0 || type == Binding::Type::Bool)
+		{
+			ofLogWarning(__FUNCTION__) << "Parameter " << parameter.getName() << " cannot be modulated";
+			return false;
+		}
+
+		// Replace any previous modulator.
+		this->remove(parameter);
+
+		Target target{ Binding(parameter.newReference(), parameter.getName()), &modulator };
+		target.offset = this->baseValues.size();
+		target.count = target.binding.getNumComponents();
+		target.phase = 0.0f;
+		target.walk = 0.0f;
+		target.envelopeTime = std::numeric_limits<float>::max();
+		target.triggerCount = modulator.getTriggerCount();
+
+		float values[Binding::kMaxComponents];
+		float minValues[Binding::kMaxComponents];
+		float maxValues[Binding::kMaxComponents];
+		target.binding.getComponents(values);
+		target.binding.getRange(minValues, maxValues);
+		this->baseValues.insert(this->baseValues.end(), values, values + target.count);
+		this->lastValues.insert(this->lastValues.end(), values, values + target.count);
+		this->minValues.insert(this->minValues.end(), minValues, minValues + target.count);
+		this->maxValues.insert(this->maxValues.end(), maxValues, maxValues + target.count);
+		this->amounts.resize(this->baseValues.size(), 0.0f);
+		this->outValues.resize(this->baseValues.size(), 0.0f);
+
+		GetModulations()[target.binding.identity] = this;
+		this->targets.push_back(target);
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	bool Modulation::remove(const ofAbstractParameter & parameter)
+	{
+		const auto identity = Binding::GetIdentity(parameter, Binding::GetType(parameter));
+		for (auto it = this->targets.begin(); it != this->targets.end(); ++it)
+		{
+			if (it->binding.identity != identity)
+			{
+				continue;
+			}
+
+			auto & modulations = GetModulations();
+			const auto modulation = modulations.find(identity);
+			if (modulation != modulations.end() && modulation->second == this)
+			{
+				modulations.erase(modulation);
+			}
+
+			// Remove its lanes and shift the ones after it.
+			const auto offset = it->offset;
+			const auto count = it->count;
+			for (auto lanes : { &this->baseValues, &this->lastValues, &this->minValues, &this->maxValues, &this->amounts, &this->outValues })
+			{
+				lanes->erase(lanes->begin() + offset, lanes->begin() + offset + count);
+			}
+			it = this->targets.erase(it);
+			for (; it != this->targets.end(); ++it)
+			{
+				it->offset -= count;
+			}
+			return true;
+		}
+		return false;
+	}
+
+	//--------------------------------------------------------------
+	void Modulation::clear()
+	{
+		auto & modulations = GetModulations();
+		for (const auto & target : this->targets)
+		{
+			const auto it = modulations.find(target.binding.identity);
+			if (it != modulations.end() && it->second == this)
+			{
+				modulations.erase(it);
+			}
+		}
+
+		this->targets.clear();
+		this->baseValues.clear();
+		this->lastValues.clear();
+		this->minValues.clear();
+		this->maxValues.clear();
+		this->amounts.clear();
+		this->outValues.clear();
+	}
+
+	//--------------------------------------------------------------
+	size_t Modulation::size() const
+	{
+		return this->targets.size();
+	}
+
+	//--------------------------------------------------------------
+	bool Modulation::empty() const
+	{
+		return this->targets.empty();
+	}
+
+	//--------------------------------------------------------------
+	void Modulation::update()
+	{
+		this->update(ofGetLastFrameTime());
+	}
+
+	//--------------------------------------------------------------
+	void Modulation::update(float deltaTime)
+	{
+		if (this->targets.empty())
+		{
+			return;
+		}
+
+		// Advance every target and evaluate its modulator once.
+		for (size_t i = 0; i < this->targets.size(); ++i)
+		{
+			auto & target = this->targets[i];
+			const auto & modulator = *target.modulator;
+
+			// Anything other than our last write was set from outside and becomes the new base.
+			float values[Binding::kMaxComponents];
+			target.binding.getComponents(values);
+			if (!std::equal(values, values + target.count, this->lastValues.begin() + target.offset))
+			{
+				std::copy(values, values + target.count, this->baseValues.begin() + target.offset);
+			}
+			target.binding.getRange(&this->minValues[target.offset], &this->maxValues[target.offset]);
+
+			// Wrap the phase so noise does not lose precision over long runs.
+			target.phase = fmodf(target.phase + modulator.frequency * deltaTime, 256.0f);
+
+			auto amount = 0.0f;
+			if (modulator.enabled)
+			{
+				auto wave = 0.0f;
+				if (modulator.shape == Modulator::RandomWalk)
+				{
+					target.walk = ofClamp(target.walk + ofRandomf() * modulator.frequency * deltaTime, -1.0f, 1.0f);
+					wave = target.walk;
+				}
+				else if (modulator.shape == Modulator::Envelope)
+				{
+					if (target.triggerCount != modulator.getTriggerCount())
+					{
+						target.triggerCount = modulator.getTriggerCount();
+						target.envelopeTime = 0.0f;
+					}
+					else if (target.envelopeTime < std::numeric_limits<float>::max())
+					{
+						target.envelopeTime += deltaTime;
+					}
+
+					// Unipolar attack / release ramp.
+					if (target.envelopeTime < modulator.attack)
+					{
+						wave = target.envelopeTime / modulator.attack;
+					}
+					else if (modulator.release > 0.0f)
+					{
+						wave = std::max(0.0f, 1.0f - (target.envelopeTime - modulator.attack) / modulator.release);
+					}
+				}
+				else
+				{
+					wave = Evaluate(modulator.shape, target.phase + modulator.phase, i * 17.31f);
+				}
+				amount = modulator.depth * wave;
+			}
+			std::fill(this->amounts.begin() + target.offset, this->amounts.begin() + target.offset + target.count, amount);
+		}
+
+		// Compute all the lanes in one go.
+		const auto numLanes = this->outValues.size();
+		const auto baseValues = this->baseValues.data();
+		const auto minValues = this->minValues.data();
+		const auto maxValues = this->maxValues.data();
+		const auto amounts = this->amounts.data();
+		const auto outValues = this->outValues.data();
+		for (size_t i = 0; i < numLanes; ++i)
+		{
+			const auto value = baseValues[i] + amounts[i] * (maxValues[i] - minValues[i]) * 0.5f;
+			outValues[i] = std::min(std::max(value, minValues[i]), maxValues[i]);
+		}
+
+		// Write the results in one transaction, so everyone hears about the whole batch at once.
+		Transaction transaction(this->group);
+		for (auto & target : this->targets)
+		{
+			transaction.set(*target.binding.parameter, target.binding.type, &this->outValues[target.offset]);
+
+			// Read back what was actually stored, ints get rounded.
+			target.binding.getComponents(&this->lastValues[target.offset]);
+		}
+		transaction.commit();
+	}
+}
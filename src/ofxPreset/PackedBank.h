@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Bank.h"
+#include "Store.h"
+
+namespace ofxPreset
+{
+	// Compressed copy of a Bank, small enough to keep large preset libraries in memory.
+	// Every value is quantized to the range of its parameter and stored as the difference with a reference preset
+	// (the per-component median). Unchanged values take a single bit and the others are Rice coded,
+	// so near-identical presets only take a few bytes.
+	class PackedBank
+	{
+	public:
+		static const uint32_t kMagic = 0x5042464f; // "OFBP"
+		static const size_t kDefaultBits = 16;
+		static const size_t kMaxBits = 24;
+
+		inline PackedBank();
+
+		// Quantizes with the current ranges of the store, on the given number of bits per component.
+		// Components without a finite range are kept as raw floats.
+		inline void pack(const Bank & bank, const Store & store, size_t bits = kDefaultBits);
+		inline bool unpack(Bank & bank) const;
+		inline void clear();
+
+		inline size_t size() const;
+		inline bool empty() const;
+
+		inline size_t getStride() const;
+		inline uint64_t getSchemaHash() const;
+
+		inline const string & getName(size_t index) const;
+		inline int indexOf(const string & name) const;
+
+		// Decodes a single preset.
+		inline void get(size_t index, Store::Snapshot & snapshot) const;
+
+		// Size of the encoded values, without the names.
+		inline size_t getNumBytes() const;
+
+		inline bool save(const string & filePath) const;
+		inline bool load(const string & filePath);
+
+	protected:
+		static const size_t kEscape = 24;
+
+		class BitWriter
+		{
+		public:
+			inline BitWriter(vector<uint8_t> & bytes);
+			inline void write(uint32_t value, size_t numBits);
+			inline void writeRice(uint32_t value, size_t k);
+			inline void flush();
+
+		protected:
+			vector<uint8_t> & bytes;
+			uint64_t buffer;
+			size_t numBuffered;
+		};
+
+		class BitReader
+		{
+		public:
+			inline BitReader(const uint8_t * data, const uint8_t * end);
+			inline uint32_t read(size_t numBits);
+			inline uint32_t readRice(size_t k);
+			inline const uint8_t * getPosition() const;
+			inline bool isValid() const;
+
+		protected:
+			const uint8_t * data;
+			const uint8_t * end;
+			uint64_t buffer;
+			size_t numBuffered;
+			bool valid;
+		};
+
+		static inline uint32_t ZigZag(int32_t value);
+		static inline int32_t UnZigZag(uint32_t value);
+		static inline size_t GetRiceSize(uint32_t value, size_t k);
+
+		inline bool isQuantized(size_t component) const;
+		inline uint32_t quantize(size_t component, float value) const;
+		inline void encode(const float * values);
+		inline bool decode(size_t offset, float * values, size_t & nextOffset) const;
+		inline bool buildOffsets();
+
+		size_t stride;
+		size_t bits;
+		uint64_t schemaHash;
+
+		vector<float> minValues;
+		vector<float> steps;
+		vector<uint32_t> reference;
+
+		vector<string> names;
+		vector<uint8_t> data;
+		vector<size_t> offsets;
+	};
+}
+
+#include "PackedBank.inl"
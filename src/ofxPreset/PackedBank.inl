@@ -0,0 +1,512 @@
+#include "PackedBank.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	PackedBank::BitWriter::BitWriter(vector<uint8_t> & bytes)
+		: bytes(bytes)
+		, buffer(0)
+		, numBuffered(0)
+	{}
+
+	//--------------------------------------------------------------
+	void PackedBank::BitWriter::write(uint32_t value, size_t numBits)
+	{
+		this->buffer |= static_cast<uint64_t>(value) << this->numBuffered;
+		this->numBuffered += numBits;
+		while (this->numBuffered >= 8)
+		{
+			this->bytes.push_back(static_cast<uint8_t>(this->buffer));
+			this->buffer >>= 8;
+			this->numBuffered -= 8;
+		}
+	}
+
+	//--------------------------------------------------------------
+	void PackedBank::BitWriter::writeRice(uint32_t value, size_t k)
+	{
+		const auto quotient = value >> k;
+		if (quotient >= kEscape)
+		{
+			// Too far from the reference, write the value as is.
+			this->write((1u << kEscape) - 1, kEscape);
+			this->write(value, 32);
+			return;
+		}
+
+		// Unary quotient terminated by a 0, then the k low bits.
+		this->write((1u << quotient) - 1, quotient + 1);
+		if (k > 0)
+		{
+			this->write(value & ((1u << k) - 1), k);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void PackedBank::BitWriter::flush()
+	{
+		if (this->numBuffered > 0)
+		{
+			this->bytes.push_back(static_cast<uint8_t>(this->buffer));
+			this->buffer = 0;
+			this->numBuffered = 0;
+		}
+	}
+
+	//--------------------------------------------------------------
+	PackedBank::BitReader::BitReader(const uint8_t * data, const uint8_t * end)
+		: data(data)
+		, end(end)
+		, buffer(0)
+		, numBuffered(0)
+		, valid(true)
+	{}
+
+	//--------------------------------------------------------------
+	uint32_t PackedBank::BitReader::read(size_t numBits)
+	{
+		while (this->numBuffered < numBits)
+		{
+			if (this->data == this->end)
+			{
+				this->valid = false;
+				return 0;
+			}
+			this->buffer |= static_cast<uint64_t>(*this->data++) << this->numBuffered;
+			this->numBuffered += 8;
+		}
+
+		const auto value = static_cast<uint32_t>(this->buffer & ((1ULL << numBits) - 1));
+		this->buffer >>= numBits;
+		this->numBuffered -= numBits;
+		return value;
+	}
+
+	//--------------------------------------------------------------
+	uint32_t PackedBank::BitReader::readRice(size_t k)
+	{
+		uint32_t quotient = 0;
+		while (quotient < kEscape && this->read(1))
+		{
+			++quotient;
+		}
+		if (quotient == kEscape)
+		{
+			return this->read(32);
+		}
+		return (quotient << k) | this->read(k);
+	}
+
+	//--------------------------------------------------------------
+	const uint8_t * PackedBank::BitReader::getPosition() const
+	{
+		// Bytes are only fetched when needed, anything left in the buffer is padding.
+		return this->data;
+	}
+
+	//--------------------------------------------------------------
+	bool PackedBank::BitReader::isValid() const
+	{
+		return this->valid;
+	}
+
+	//--------------------------------------------------------------
+	uint32_t PackedBank::ZigZag(int32_t value)
+	{
+		return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+	}
+
+	//--------------------------------------------------------------
+	int32_t PackedBank::UnZigZag(uint32_t value)
+	{
+		return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+	}
+
+	//--------------------------------------------------------------
+	size_t PackedBank::GetRiceSize(uint32_t value, size_t k)
+	{
+		const auto quotient = value >> k;
+		return (quotient >= kEscape) ? kEscape + 32 : quotient + 1 + k;
+	}
+
+	//--------------------------------------------------------------
+	PackedBank::PackedBank()
+		: stride(0)
+		, bits(kDefaultBits)
+		, schemaHash(0)
+	{}
+
+	//--------------------------------------------------------------
+	void PackedBank::pack(const Bank & bank, const Store & store, size_t bits)
+	{
+		this->clear();
+
+		if (bank.getStride() != store.size())
+		{
+			ofLogWarning(__FUNCTION__) << "Bank does not match the store!";
+			return;
+		}
+
+		this->stride = bank.getStride();
+		this->bits = (bits < 1) ? 1 : (bits > kMaxBits) ? kMaxBits : bits;
+		this->schemaHash = bank.getSchemaHash();
+
+		Store::Snapshot maxValues;
+		vector<uint8_t> integers;
+		store.getRange(this->minValues, maxValues);
+		store.getIntegers(integers);
+		const auto numLevels = static_cast<float>((1u << this->bits) - 1);
+		this->steps.assign(this->stride, 0.0f);
+		for (size_t i = 0; i < this->stride; ++i)
+		{
+			// Ints are only quantized if every value keeps its own level, the others are stored raw.
+			const auto range = maxValues[i] - this->minValues[i];
+			if (std::isfinite(range) && range > 0.0f && (!integers[i] || range <= numLevels))
+			{
+				this->steps[i] = range / numLevels;
+			}
+		}
+
+		// The median of each component is the closest reference for most presets.
+		this->reference.assign(this->stride, 0);
+		vector<uint32_t> levels(bank.size());
+		for (size_t i = 0; i < this->stride && !levels.empty(); ++i)
+		{
+			if (!this->isQuantized(i))
+			{
+				continue;
+			}
+			for (size_t j = 0; j < bank.size(); ++j)
+			{
+				levels[j] = this->quantize(i, bank.getValues(j)[i]);
+			}
+			std::nth_element(levels.begin(), levels.begin() + levels.size() / 2, levels.end());
+			this->reference[i] = levels[levels.size() / 2];
+		}
+
+		for (size_t i = 0; i < bank.size(); ++i)
+		{
+			this->names.push_back(bank.getName(i));
+			this->encode(bank.getValues(i));
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool PackedBank::unpack(Bank & bank) const
+	{
+		if (bank.getStride() != this->stride || bank.getSchemaHash() != this->schemaHash)
+		{
+			ofLogError(__FUNCTION__) << "Bank was set up from a different group layout!";
+			return false;
+		}
+
+		bank.clear();
+		vector<float> values(this->stride);
+		size_t nextOffset;
+		for (size_t i = 0; i < this->names.size(); ++i)
+		{
+			if (!this->decode(this->offsets[i], values.data(), nextOffset))
+			{
+				return false;
+			}
+			bank.add(this->names[i], values.data());
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	void PackedBank::clear()
+	{
+		this->stride = 0;
+		this->schemaHash = 0;
+		this->minValues.clear();
+		this->steps.clear();
+		this->reference.clear();
+		this->names.clear();
+		this->data.clear();
+		this->offsets.clear();
+	}
+
+	//--------------------------------------------------------------
+	size_t PackedBank::size() const
+	{
+		return this->names.size();
+	}
+
+	//--------------------------------------------------------------
+	bool PackedBank::empty() const
+	{
+		return this->names.empty();
+	}
+
+	//--------------------------------------------------------------
+	size_t PackedBank::getStride() const
+	{
+		return this->stride;
+	}
+
+	//--------------------------------------------------------------
+	uint64_t PackedBank::getSchemaHash() const
+	{
+		return this->schemaHash;
+	}
+
+	//--------------------------------------------------------------
+	const string & PackedBank::getName(size_t index) const
+	{
+		return this->names[index];
+	}
+
+	//--------------------------------------------------------------
+	int PackedBank::indexOf(const string & name) const
+	{
+		const auto it = std::find(this->names.begin(), this->names.end(), name);
+		return (it == this->names.end()) ? -1 : static_cast<int>(it - this->names.begin());
+	}
+
+	//--------------------------------------------------------------
+	void PackedBank::get(size_t index, Store::Snapshot & snapshot) const
+	{
+		if (index >= this->names.size())
+		{
+			ofLogWarning(__FUNCTION__) << "Index " << index << " out of range!";
+			return;
+		}
+
+		snapshot.resize(this->stride);
+		size_t nextOffset;
+		this->decode(this->offsets[index], snapshot.data(), nextOffset);
+	}
+
+	//--------------------------------------------------------------
+	size_t PackedBank::getNumBytes() const
+	{
+		return this->data.size();
+	}
+
+	//--------------------------------------------------------------
+	bool PackedBank::save(const string & filePath) const
+	{
+		auto file = fopen(ofToDataPath(filePath, true).c_str(), "wb");
+		if (!file)
+		{
+			ofLogError(__FUNCTION__) << "Could not open " << filePath << " for writing!";
+			return false;
+		}
+
+		const auto magic = kMagic;
+		const auto stride = static_cast<uint32_t>(this->stride);
+		const auto bits = static_cast<uint32_t>(this->bits);
+		const auto count = static_cast<uint32_t>(this->names.size());
+		const auto numBytes = static_cast<uint32_t>(this->data.size());
+		fwrite(&magic, sizeof(magic), 1, file);
+		fwrite(&this->schemaHash, sizeof(this->schemaHash), 1, file);
+		fwrite(&stride, sizeof(stride), 1, file);
+		fwrite(&bits, sizeof(bits), 1, file);
+		fwrite(&count, sizeof(count), 1, file);
+		fwrite(this->minValues.data(), sizeof(float), this->stride, file);
+		fwrite(this->steps.data(), sizeof(float), this->stride, file);
+		fwrite(this->reference.data(), sizeof(uint32_t), this->stride, file);
+		for (const auto & name : this->names)
+		{
+			const auto length = static_cast<uint16_t>(std::min<size_t>(name.size(), UINT16_MAX));
+			fwrite(&length, sizeof(length), 1, file);
+			fwrite(name.data(), 1, length, file);
+		}
+		// Offsets are rebuilt on load, presets are byte aligned.
+		fwrite(&numBytes, sizeof(numBytes), 1, file);
+		fwrite(this->data.data(), 1, this->data.size(), file);
+
+		const auto success = !ferror(file);
+		fclose(file);
+		return success;
+	}
+
+	//--------------------------------------------------------------
+	bool PackedBank::load(const string & filePath)
+	{
+		auto file = fopen(ofToDataPath(filePath, true).c_str(), "rb");
+		if (!file)
+		{
+			ofLogWarning(__FUNCTION__) << "Could not open " << filePath << "!";
+			return false;
+		}
+
+		this->clear();
+
+		uint32_t magic = 0;
+		uint32_t stride = 0;
+		uint32_t bits = 0;
+		uint32_t count = 0;
+		auto success = fread(&magic, sizeof(magic), 1, file) == 1 && fread(&this->schemaHash, sizeof(this->schemaHash), 1, file) == 1
+			&& fread(&stride, sizeof(stride), 1, file) == 1 && fread(&bits, sizeof(bits), 1, file) == 1
+			&& fread(&count, sizeof(count), 1, file) == 1 && magic == kMagic && bits > 0 && bits <= kMaxBits;
+		if (!success)
+		{
+			ofLogError(__FUNCTION__) << "File " << filePath << " is not a packed bank!";
+			fclose(file);
+			this->clear();
+			return false;
+		}
+
+		// Everything below is sized from the header, make sure the file can hold it before allocating.
+		const auto headerSize = ftell(file);
+		fseek(file, 0, SEEK_END);
+		const auto fileSize = ftell(file);
+		fseek(file, headerSize, SEEK_SET);
+		const auto minSize = static_cast<uint64_t>(stride) * (sizeof(float) * 2 + sizeof(uint32_t)) + static_cast<uint64_t>(count) * sizeof(uint16_t) + sizeof(uint32_t);
+		if (headerSize < 0 || fileSize < headerSize || minSize > static_cast<uint64_t>(fileSize - headerSize))
+		{
+			ofLogError(__FUNCTION__) << "Packed bank " << filePath << " is truncated!";
+			fclose(file);
+			this->clear();
+			return false;
+		}
+
+		this->stride = stride;
+		this->bits = bits;
+		this->minValues.resize(stride);
+		this->steps.resize(stride);
+		this->reference.resize(stride);
+		success = fread(this->minValues.data(), sizeof(float), stride, file) == stride
+			&& fread(this->steps.data(), sizeof(float), stride, file) == stride
+			&& fread(this->reference.data(), sizeof(uint32_t), stride, file) == stride;
+
+		this->names.resize(count);
+		for (auto & name : this->names)
+		{
+			uint16_t length = 0;
+			success = success && fread(&length, sizeof(length), 1, file) == 1;
+			name.resize(length);
+			success = success && (!length || fread(&name[0], 1, length, file) == length);
+		}
+
+		uint32_t numBytes = 0;
+		success = success && fread(&numBytes, sizeof(numBytes), 1, file) == 1;
+		success = success && numBytes <= static_cast<uint64_t>(fileSize - ftell(file));
+		this->data.resize(success ? numBytes : 0);
+		success = success && fread(this->data.data(), 1, this->data.size(), file) == this->data.size();
+		fclose(file);
+
+		if (!success || !this->buildOffsets())
+		{
+			ofLogError(__FUNCTION__) << "Packed bank " << filePath << " is truncated!";
+			this->clear();
+			return false;
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	bool PackedBank::isQuantized(size_t component) const
+	{
+		return this->steps[component] > 0.0f;
+	}
+
+	//--------------------------------------------------------------
+	uint32_t PackedBank::quantize(size_t component, float value) const
+	{
+		const auto maxLevel = static_cast<float>((1u << this->bits) - 1);
+		const auto level = std::round((value - this->minValues[component]) / this->steps[component]);
+		return static_cast<uint32_t>(std::min(std::max(level, 0.0f), maxLevel));
+	}
+
+	//--------------------------------------------------------------
+	void PackedBank::encode(const float * values)
+	{
+		vector<uint32_t> deltas(this->stride, 0);
+		for (size_t i = 0; i < this->stride; ++i)
+		{
+			if (this->isQuantized(i))
+			{
+				deltas[i] = ZigZag(static_cast<int32_t>(this->quantize(i, values[i])) - static_cast<int32_t>(this->reference[i]));
+			}
+		}
+
+		// Pick the Rice parameter that gives the smallest preset, unchanged values always take a single bit.
+		size_t bestK = 0;
+		size_t bestSize = SIZE_MAX;
+		for (size_t k = 0; k <= this->bits + 1; ++k)
+		{
+			size_t size = 0;
+			for (auto delta : deltas)
+			{
+				if (delta)
+				{
+					size += GetRiceSize(delta - 1, k);
+				}
+			}
+			if (size < bestSize)
+			{
+				bestSize = size;
+				bestK = k;
+			}
+		}
+
+		this->offsets.push_back(this->data.size());
+		BitWriter writer(this->data);
+		writer.write(static_cast<uint32_t>(bestK), 5);
+		for (size_t i = 0; i < this->stride; ++i)
+		{
+			if (!this->isQuantized(i))
+			{
+				uint32_t raw;
+				memcpy(&raw, &values[i], sizeof(raw));
+				writer.write(raw, 32);
+			}
+			else if (deltas[i] == 0)
+			{
+				writer.write(0, 1);
+			}
+			else
+			{
+				writer.write(1, 1);
+				writer.writeRice(deltas[i] - 1, bestK);
+			}
+		}
+		writer.flush();
+	}
+
+	//--------------------------------------------------------------
+	bool PackedBank::decode(size_t offset, float * values, size_t & nextOffset) const
+	{
+		BitReader reader(this->data.data() + offset, this->data.data() + this->data.size());
+		const auto k = reader.read(5);
+		for (size_t i = 0; i < this->stride; ++i)
+		{
+			if (!this->isQuantized(i))
+			{
+				const auto raw = reader.read(32);
+				memcpy(&values[i], &raw, sizeof(raw));
+				continue;
+			}
+
+			auto level = static_cast<int32_t>(this->reference[i]);
+			if (reader.read(1))
+			{
+				level += UnZigZag(reader.readRice(k) + 1);
+			}
+			values[i] = this->minValues[i] + level * this->steps[i];
+		}
+		nextOffset = reader.getPosition() - this->data.data();
+		return reader.isValid();
+	}
+
+	//--------------------------------------------------------------
+	bool PackedBank::buildOffsets()
+	{
+		// Decode everything once to find where each preset starts.
+		this->offsets.clear();
+		vector<float> values(this->stride);
+		size_t offset = 0;
+		for (size_t i = 0; i < this->names.size(); ++i)
+		{
+			this->offsets.push_back(offset);
+			if (!this->decode(offset, values.data(), offset))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
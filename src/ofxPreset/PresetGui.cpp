@@ -1,6 +0,0 @@
-#include "Gui.h"
-
-namespace ofxPreset
-{
-	Gui::WindowOpen Gui::windowOpen;
-}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+
+#include "ofEvents.h"
+#include "ofParameter.h"
+
+#include "Bindings.h"
+
+namespace ofxPreset
+{
+	// Measures the time spent in the change listeners of every parameter in a group.
+	// Timers are added as the first and last listeners of each parameter and of every group above it,
+	// so the time covers the parameter's own listeners and the group listeners it triggers, including nested changes.
+	class Profiler
+	{
+	public:
+		struct Entry
+		{
+			string path;
+			size_t count;
+			double totalTime;
+			double maxTime;
+		};
+
+		inline Profiler();
+
+		// Timers use the lowest and highest listener priorities, so they wrap every other listener.
+		inline void setup(ofParameterGroup & group);
+		inline void clear();
+
+		// Clears the measurements, keeping the timers.
+		inline void reset();
+
+		inline void setEnabled(bool enabled);
+		inline bool isEnabled() const;
+
+		inline size_t size() const;
+		inline const Entry & operator[](size_t index) const;
+
+		// Indices of the entries that were notified at least once, most expensive first.
+		inline vector<size_t> getSortedIndices() const;
+
+		// Seconds spent in all listeners since the last reset.
+		inline double getTotalTime() const;
+
+	protected:
+		typedef std::chrono::steady_clock Clock;
+
+		template<typename ParameterType>
+		inline void addTimers(size_t index);
+		inline void addGroupTimers(ofParameterGroup & group, bool root);
+
+		inline void begin(size_t index);
+		inline void end(size_t index);
+
+		struct Timer
+		{
+			size_t index;
+			Clock::time_point start;
+		};
+
+		Bindings bindings;
+		ofEventListeners listeners;
+
+		vector<Entry> entries;
+		vector<Timer> timers;
+		double totalTime;
+		bool enabled;
+	};
+}
+
+#include "Profiler.inl"
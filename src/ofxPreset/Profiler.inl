@@ -0,0 +1,210 @@
+#include "Profiler.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	Profiler::Profiler()
+		: totalTime(0.0)
+		, enabled(true)
+	{}
+
+	//--------------------------------------------------------------
+	void Profiler::setup(ofParameterGroup & group)
+	{
+		this->clear();
+
+		this->bindings.setup(group);
+		this->entries.resize(this->bindings.size());
+		for (size_t i = 0; i < this->bindings.size(); ++i)
+		{
+			this->entries[i].path = this->bindings[i].path;
+
+			switch (this->bindings[i].type)
+			{
+			case Binding::Type::Bool: this->addTimers<bool>(i); break;
+			case Binding::Type::Int: this->addTimers<int>(i); break;
+			case Binding::Type::Float: this->addTimers<float>(i); break;
+			case Binding::Type::Vec2: this->addTimers<glm::vec2>(i); break;
+			case Binding::Type::Vec3: this->addTimers<glm::vec3>(i); break;
+			case Binding::Type::Vec4: this->addTimers<glm::vec4>(i); break;
+			case Binding::Type::OfVec2: this->addTimers<ofVec2f>(i); break;
+			case Binding::Type::OfVec3: this->addTimers<ofVec3f>(i); break;
+			case Binding::Type::OfVec4: this->addTimers<ofVec4f>(i); break;
+			case Binding::Type::FloatColor: this->addTimers<ofFloatColor>(i); break;
+			case Binding::Type::String: this->addTimers<string>(i); break;
+			case Binding::Type::AssetPath: this->addTimers<AssetPath>(i); break;
+			default:
+				// Unknown types are only timed from their group's listeners.
+				break;
+			}
+		}
+		this->addGroupTimers(this->bindings.getGroup(), true);
+
+		this->reset();
+	}
+
+	//--------------------------------------------------------------
+	void Profiler::clear()
+	{
+		this->listeners.unsubscribeAll();
+		this->bindings.clear();
+		this->entries.clear();
+		this->timers.clear();
+		this->totalTime = 0.0;
+	}
+
+	//--------------------------------------------------------------
+	void Profiler::reset()
+	{
+		for (auto & entry : this->entries)
+		{
+			entry.count = 0;
+			entry.totalTime = 0.0;
+			entry.maxTime = 0.0;
+		}
+		this->timers.clear();
+		this->totalTime = 0.0;
+	}
+
+	//--------------------------------------------------------------
+	void Profiler::setEnabled(bool enabled)
+	{
+		this->enabled = enabled;
+		this->timers.clear();
+	}
+
+	//--------------------------------------------------------------
+	bool Profiler::isEnabled() const
+	{
+		return this->enabled;
+	}
+
+	//--------------------------------------------------------------
+	size_t Profiler::size() const
+	{
+		return this->entries.size();
+	}
+
+	//--------------------------------------------------------------
+	const Profiler::Entry & Profiler::operator[](size_t index) const
+	{
+		return this->entries[index];
+	}
+
+	//--------------------------------------------------------------
+	vector<size_t> Profiler::getSortedIndices() const
+	{
+		vector<size_t> indices;
+		for (size_t i = 0; i < this->entries.size(); ++i)
+		{
+			if (this->entries[i].count)
+			{
+				indices.push_back(i);
+			}
+		}
+		std::sort(indices.begin(), indices.end(), [this](size_t a, size_t b)
+		{
+			return this->entries[a].totalTime > this->entries[b].totalTime;
+		});
+		return indices;
+	}
+
+	//--------------------------------------------------------------
+	double Profiler::getTotalTime() const
+	{
+		return this->totalTime;
+	}
+
+	//--------------------------------------------------------------
+	template<typename ParameterType>
+	void Profiler::addTimers(size_t index)
+	{
+		auto & parameter = this->bindings[index].parameter->cast<ParameterType>();
+		this->listeners.push(parameter.newListener([this, index](ParameterType &)
+		{
+			this->begin(index);
+		}, std::numeric_limits<int>::min()));
+	}
+
+	//--------------------------------------------------------------
+	void Profiler::addGroupTimers(ofParameterGroup & group, bool root)
+	{
+		// Every group notifies its parent after its own listeners, so only the root group stops the timer.
+		this->listeners.push(group.parameterChangedE().newListener([this](ofAbstractParameter & parameter)
+		{
+			const auto index = this->bindings.indexOf(parameter);
+			if (index >= 0)
+			{
+				this->begin(index);
+			}
+		}, std::numeric_limits<int>::min()));
+		if (root)
+		{
+			this->listeners.push(group.parameterChangedE().newListener([this](ofAbstractParameter & parameter)
+			{
+				const auto index = this->bindings.indexOf(parameter);
+				if (index >= 0)
+				{
+					this->end(index);
+				}
+			}, std::numeric_limits<int>::max()));
+		}
+
+		for (const auto & parameter : group)
+		{
+			// Group.
+			auto parameterGroup = dynamic_pointer_cast<ofParameterGroup>(parameter);
+			if (parameterGroup)
+			{
+				// Recurse through contents.
+				this->addGroupTimers(*parameterGroup, false);
+			}
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Profiler::begin(size_t index)
+	{
+		if (!this->enabled)
+		{
+			return;
+		}
+
+		// Already started by the parameter or a group below.
+		if (!this->timers.empty() && this->timers.back().index == index)
+		{
+			return;
+		}
+		this->timers.push_back(Timer{ index, Clock::now() });
+	}
+
+	//--------------------------------------------------------------
+	void Profiler::end(size_t index)
+	{
+		auto it = this->timers.rbegin();
+		while (it != this->timers.rend() && it->index != index)
+		{
+			++it;
+		}
+		if (it == this->timers.rend())
+		{
+			// Started while disabled.
+			return;
+		}
+
+		// Drop any timer above it, a listener stopped their notification before it reached the root group.
+		const auto time = std::chrono::duration<double>(Clock::now() - it->start).count();
+		this->timers.erase(std::prev(it.base()), this->timers.end());
+
+		auto & entry = this->entries[index];
+		++entry.count;
+		entry.totalTime += time;
+		entry.maxTime = std::max(entry.maxTime, time);
+
+		// Nested changes are already included in their parent's time.
+		if (this->timers.empty())
+		{
+			this->totalTime += time;
+		}
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "ofxNetwork.h"
+
+#include "Bindings.h"
+
+namespace ofxPreset
+{
+	// Binary batches of parameter updates, addressed by binding index.
+	// Numeric values are packed as raw floats, strings as a length and bytes.
+	class Remote
+	{
+	public:
+		static const uint32_t kMagic = 0x50584f46; // "FOXP"
+		static const size_t kHeaderSize = sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint16_t);
+		static const size_t kMaxPacketSize = 1472;
+		static const unsigned short kDefaultPort = 9500;
+
+		static inline size_t GetRecordSize(const Binding & binding, const string & value);
+		static inline void WriteHeader(vector<char> & buffer, uint64_t schemaHash);
+		static inline void WriteRecord(vector<char> & buffer, uint16_t index, const Binding & binding, const string & value);
+	};
+
+	// Control side: collects changes on a group and sends them once per frame.
+	class RemoteClient
+	{
+	public:
+		inline RemoteClient();
+		inline ~RemoteClient();
+
+		inline bool setup(ofParameterGroup & group, const string & host, unsigned short port = Remote::kDefaultPort);
+		inline void close();
+
+		// Sends every parameter on the next update(), useful after (re)connecting.
+		inline void sendAll();
+
+		// Sends the latest value of each parameter changed since the last call.
+		inline void update();
+
+	protected:
+		inline void markDirty(size_t index);
+		inline void flush(uint16_t count);
+
+		Bindings bindings;
+		ofxUDPManager udp;
+		ofEventListener listener;
+
+		vector<bool> dirty;
+		vector<uint16_t> dirtyIndices;
+		vector<char> buffer;
+		bool connected;
+	};
+
+	// Render side: receives batches and applies them on the calling thread.
+	class RemoteServer
+	{
+	public:
+		inline RemoteServer();
+		inline ~RemoteServer();
+
+		inline bool setup(ofParameterGroup & group, unsigned short port = Remote::kDefaultPort);
+		inline void close();
+
+		// Drains all pending packets, coalesces them, then sets each changed parameter once.
+		// Call this at the frame boundary, i.e. at the start of ofApp::update().
+		inline size_t update();
+
+	protected:
+		inline void receive(const char * data, size_t size);
+
+		Bindings bindings;
+		ofxUDPManager udp;
+
+		vector<float> pendingValues;
+		vector<string> pendingStrings;
+		vector<bool> pending;
+		vector<uint16_t> pendingIndices;
+		vector<char> buffer;
+		bool connected;
+		bool schemaWarned;
+	};
+}
+
+#include "Remote.inl"
@@ -0,0 +1,350 @@
+#include "Remote.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	size_t Remote::GetRecordSize(const Binding & binding, const string & value)
+	{
+		if (binding.isNumeric())
+		{
+			return sizeof(uint16_t) + binding.getNumComponents() * sizeof(float);
+		}
+		return sizeof(uint16_t) + sizeof(uint16_t) + value.size();
+	}
+
+	//--------------------------------------------------------------
+	void Remote::WriteHeader(vector<char> & buffer, uint64_t schemaHash)
+	{
+		buffer.resize(kHeaderSize);
+		auto data = buffer.data();
+		const auto magic = kMagic;
+		memcpy(data, &magic, sizeof(magic));
+		memcpy(data + sizeof(magic), &schemaHash, sizeof(schemaHash));
+
+		// The record count is filled in before sending.
+		const uint16_t count = 0;
+		memcpy(data + sizeof(magic) + sizeof(schemaHash), &count, sizeof(count));
+	}
+
+	//--------------------------------------------------------------
+	void Remote::WriteRecord(vector<char> & buffer, uint16_t index, const Binding & binding, const string & value)
+	{
+		const auto offset = buffer.size();
+		buffer.resize(offset + GetRecordSize(binding, value));
+		auto data = buffer.data() + offset;
+
+		memcpy(data, &index, sizeof(index));
+		data += sizeof(index);
+
+		if (binding.isNumeric())
+		{
+			float values[Binding::kMaxComponents];
+			const auto count = binding.getComponents(values);
+			memcpy(data, values, count * sizeof(float));
+		}
+		else
+		{
+			const auto length = static_cast<uint16_t>(value.size());
+			memcpy(data, &length, sizeof(length));
+			memcpy(data + sizeof(length), value.data(), length);
+		}
+	}
+
+	//--------------------------------------------------------------
+	RemoteClient::RemoteClient()
+		: connected(false)
+	{}
+
+	//--------------------------------------------------------------
+	RemoteClient::~RemoteClient()
+	{
+		this->close();
+	}
+
+	//--------------------------------------------------------------
+	bool RemoteClient::setup(ofParameterGroup & group, const string & host, unsigned short port)
+	{
+		this->close();
+
+		this->bindings.setup(group);
+		if (this->bindings.size() > std::numeric_limits<uint16_t>::max())
+		{
+			ofLogError(__FUNCTION__) << "Group " << group.getName() << " has too many parameters to bind";
+			return false;
+		}
+
+		this->dirty.assign(this->bindings.size(), false);
+		this->dirtyIndices.clear();
+		this->dirtyIndices.reserve(this->bindings.size());
+
+		if (!this->udp.Create() || !this->udp.Connect(host.c_str(), port))
+		{
+			ofLogError(__FUNCTION__) << "Could not connect to " << host << ":" << port;
+			this->udp.Close();
+			return false;
+		}
+		this->udp.SetNonBlocking(true);
+		this->connected = true;
+
+		this->listener = this->bindings.getGroup().parameterChangedE().newListener([this](ofAbstractParameter & parameter)
+		{
+			const auto index = this->bindings.indexOf(parameter);
+			if (index >= 0)
+			{
+				this->markDirty(index);
+			}
+		});
+
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	void RemoteClient::close()
+	{
+		this->listener.unsubscribe();
+		if (this->connected)
+		{
+			this->udp.Close();
+			this->connected = false;
+		}
+	}
+
+	//--------------------------------------------------------------
+	void RemoteClient::sendAll()
+	{
+		for (size_t i = 0; i < this->bindings.size(); ++i)
+		{
+			this->markDirty(i);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void RemoteClient::update()
+	{
+		if (!this->connected || this->dirtyIndices.empty())
+		{
+			return;
+		}
+
+		const auto schemaHash = this->bindings.getSchemaHash();
+		Remote::WriteHeader(this->buffer, schemaHash);
+		uint16_t count = 0;
+
+		string value;
+		for (auto index : this->dirtyIndices)
+		{
+			this->dirty[index] = false;
+
+			const auto & binding = this->bindings[index];
+			if (!binding.isNumeric())
+			{
+				value = binding.parameter->toString();
+			}
+
+			const auto recordSize = Remote::GetRecordSize(binding, value);
+			if (Remote::kHeaderSize + recordSize > Remote::kMaxPacketSize)
+			{
+				ofLogWarning(__FUNCTION__) << "Value of " << binding.path << " is too large to send";
+				continue;
+			}
+			if (this->buffer.size() + recordSize > Remote::kMaxPacketSize)
+			{
+				// Packet is full, send it and start a new one.
+				this->flush(count);
+				Remote::WriteHeader(this->buffer, schemaHash);
+				count = 0;
+			}
+
+			Remote::WriteRecord(this->buffer, index, binding, value);
+			++count;
+		}
+		this->dirtyIndices.clear();
+
+		if (count)
+		{
+			this->flush(count);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void RemoteClient::markDirty(size_t index)
+	{
+		if (!this->dirty[index])
+		{
+			this->dirty[index] = true;
+			this->dirtyIndices.push_back(static_cast<uint16_t>(index));
+		}
+	}
+
+	//--------------------------------------------------------------
+	void RemoteClient::flush(uint16_t count)
+	{
+		memcpy(this->buffer.data() + Remote::kHeaderSize - sizeof(count), &count, sizeof(count));
+		if (this->udp.Send(this->buffer.data(), static_cast<int>(this->buffer.size())) < 0)
+		{
+			ofLogWarning(__FUNCTION__) << "Could not send " << count << " parameter updates";
+		}
+	}
+
+	//--------------------------------------------------------------
+	RemoteServer::RemoteServer()
+		: connected(false)
+		, schemaWarned(false)
+	{}
+
+	//--------------------------------------------------------------
+	RemoteServer::~RemoteServer()
+	{
+		this->close();
+	}
+
+	//--------------------------------------------------------------
+	bool RemoteServer::setup(ofParameterGroup & group, unsigned short port)
+	{
+		this->close();
+
+		this->bindings.setup(group);
+		this->pendingValues.assign(this->bindings.size() * Binding::kMaxComponents, 0.0f);
+		this->pendingStrings.assign(this->bindings.size(), string());
+		this->pending.assign(this->bindings.size(), false);
+		this->pendingIndices.clear();
+		this->buffer.resize(65536);
+		this->schemaWarned = false;
+
+		if (!this->udp.Create() || !this->udp.Bind(port))
+		{
+			ofLogError(__FUNCTION__) << "Could not bind to port " << port;
+			this->udp.Close();
+			return false;
+		}
+		this->udp.SetNonBlocking(true);
+		this->connected = true;
+
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	void RemoteServer::close()
+	{
+		if (this->connected)
+		{
+			this->udp.Close();
+			this->connected = false;
+		}
+	}
+
+	//--------------------------------------------------------------
+	size_t RemoteServer::update()
+	{
+		if (!this->connected)
+		{
+			return 0;
+		}
+
+		// Drain the socket, keeping only the latest value for each parameter.
+		int size;
+		while ((size = this->udp.Receive(this->buffer.data(), static_cast<int>(this->buffer.size()))) > 0)
+		{
+			this->receive(this->buffer.data(), size);
+		}
+
+		// Apply everything in one go.
+		for (auto index : this->pendingIndices)
+		{
+			const auto & binding = this->bindings[index];
+			if (binding.isNumeric())
+			{
+				binding.setComponents(this->pendingValues.data() + index * Binding::kMaxComponents);
+			}
+			else
+			{
+				binding.parameter->fromString(this->pendingStrings[index]);
+			}
+			this->pending[index] = false;
+		}
+
+		const auto numApplied = this->pendingIndices.size();
+		this->pendingIndices.clear();
+		return numApplied;
+	}
+
+	//--------------------------------------------------------------
+	void RemoteServer::receive(const char * data, size_t size)
+	{
+		if (size < Remote::kHeaderSize)
+		{
+			return;
+		}
+
+		uint32_t magic;
+		uint64_t schemaHash;
+		uint16_t count;
+		memcpy(&magic, data, sizeof(magic));
+		memcpy(&schemaHash, data + sizeof(magic), sizeof(schemaHash));
+		memcpy(&count, data + sizeof(magic) + sizeof(schemaHash), sizeof(count));
+		if (magic != Remote::kMagic)
+		{
+			return;
+		}
+		if (schemaHash != this->bindings.getSchemaHash())
+		{
+			if (!this->schemaWarned)
+			{
+				ofLogWarning(__FUNCTION__) << "Ignoring updates for a different parameter layout";
+				this->schemaWarned = true;
+			}
+			return;
+		}
+
+		const auto end = data + size;
+		data += Remote::kHeaderSize;
+		for (uint16_t i = 0; i < count; ++i)
+		{
+			uint16_t index;
+			if (data + sizeof(index) > end)
+			{
+				return;
+			}
+			memcpy(&index, data, sizeof(index));
+			data += sizeof(index);
+			if (index >= this->bindings.size())
+			{
+				return;
+			}
+
+			const auto & binding = this->bindings[index];
+			if (binding.isNumeric())
+			{
+				const auto numBytes = binding.getNumComponents() * sizeof(float);
+				if (data + numBytes > end)
+				{
+					return;
+				}
+				memcpy(this->pendingValues.data() + index * Binding::kMaxComponents, data, numBytes);
+				data += numBytes;
+			}
+			else
+			{
+				uint16_t length;
+				if (data + sizeof(length) > end)
+				{
+					return;
+				}
+				memcpy(&length, data, sizeof(length));
+				data += sizeof(length);
+				if (data + length > end)
+				{
+					return;
+				}
+				this->pendingStrings[index].assign(data, length);
+				data += length;
+			}
+
+			if (!this->pending[index])
+			{
+				this->pending[index] = true;
+				this->pendingIndices.push_back(index);
+			}
+		}
+	}
+}
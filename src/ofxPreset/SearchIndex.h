@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ofParameter.h"
+
+namespace ofxPreset
+{
+	// Trigram index over the paths of every group and parameter in a tree, for filtering large trees in the Gui.
+	// A query matches the entries whose lowercase path contains each of its words, in any order.
+	class SearchIndex
+	{
+	public:
+		struct Node
+		{
+			shared_ptr<ofAbstractParameter> parameter;
+			string name;
+			string path;
+			string lowerPath;
+			int parent;
+			vector<int> children;
+			bool isGroup;
+			bool alive;
+		};
+
+		inline SearchIndex();
+
+		inline void setup(ofParameterGroup & group);
+		inline void clear();
+
+		// Re-indexes the groups whose children were added, removed, replaced, reordered or renamed since the last call,
+		// leaving the rest alone. Gui::AddSearch() calls it every frame.
+		inline void update();
+
+		// Returns the matching nodes, and marks them and their ancestors as visible.
+		inline const vector<int> & search(const string & query);
+
+		inline const string & getQuery() const;
+		inline bool isVisible(int index) const;
+
+		inline const Node & operator[](size_t index) const;
+		inline size_t size() const;
+		inline ofParameterGroup & getGroup();
+
+	protected:
+		static inline uint32_t GetTrigram(const char * str);
+
+		inline int addNode(const shared_ptr<ofAbstractParameter> & parameter, const string & path, int parent);
+		inline bool haveChildrenChanged(int index) const;
+		inline void addChildren(int index);
+		inline void removeChildren(int index);
+		inline void rebuild();
+
+		ofParameterGroup group;
+		vector<Node> nodes;
+		unordered_map<uint32_t, vector<int>> postings;
+		size_t numDead;
+
+		string query;
+		vector<int> matches;
+		vector<uint32_t> visibleStamps;
+		uint32_t stamp;
+	};
+}
+
+#include "SearchIndex.inl"
@@ -0,0 +1,308 @@
+#include "SearchIndex.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	uint32_t SearchIndex::GetTrigram(const char * str)
+	{
+		return (static_cast<uint8_t>(str[0]) << 16) | (static_cast<uint8_t>(str[1]) << 8) | static_cast<uint8_t>(str[2]);
+	}
+
+	//--------------------------------------------------------------
+	SearchIndex::SearchIndex()
+		: numDead(0)
+		, stamp(0)
+	{}
+
+	//--------------------------------------------------------------
+	void SearchIndex::setup(ofParameterGroup & group)
+	{
+		this->clear();
+
+		this->group = group;
+		const auto root = this->addNode(group.newReference(), group.getName().empty() ? "" : "/" + group.getName(), -1);
+		this->addChildren(root);
+	}
+
+	//--------------------------------------------------------------
+	void SearchIndex::clear()
+	{
+		this->group = ofParameterGroup();
+		this->nodes.clear();
+		this->postings.clear();
+		this->numDead = 0;
+		this->query.clear();
+		this->matches.clear();
+		this->visibleStamps.clear();
+	}
+
+	//--------------------------------------------------------------
+	void SearchIndex::update()
+	{
+		if (this->nodes.empty())
+		{
+			return;
+		}
+
+		// The root's name is in every path.
+		if (this->group.getName() != this->nodes[0].name)
+		{
+			this->rebuild();
+			return;
+		}
+
+		// Only groups are checked, parameters cannot add children.
+		auto changed = false;
+		for (size_t i = 0; i < this->nodes.size(); ++i)
+		{
+			const auto & node = this->nodes[i];
+			if (!node.alive || !node.isGroup)
+			{
+				continue;
+			}
+
+			if (this->haveChildrenChanged(i))
+			{
+				this->removeChildren(i);
+				this->addChildren(i);
+				changed = true;
+			}
+		}
+
+		if (!changed)
+		{
+			return;
+		}
+
+		// Start over once most of the index is stale.
+		if (this->numDead > this->nodes.size() / 2)
+		{
+			this->rebuild();
+		}
+		else
+		{
+			this->search(this->query);
+		}
+	}
+
+	//--------------------------------------------------------------
+	const vector<int> & SearchIndex::search(const string & query)
+	{
+		this->query = query;
+		this->matches.clear();
+		this->visibleStamps.resize(this->nodes.size(), 0);
+		++this->stamp;
+
+		const auto words = ofSplitString(ofToLower(query), " ", true, true);
+		if (words.empty())
+		{
+			return this->matches;
+		}
+
+		// Candidates are the nodes that contain every trigram of the longer words.
+		vector<int> candidates;
+		auto filtered = false;
+		for (const auto & word : words)
+		{
+			for (size_t i = 0; i + 3 <= word.size(); ++i)
+			{
+				const auto it = this->postings.find(GetTrigram(word.c_str() + i));
+				if (it == this->postings.end())
+				{
+					return this->matches;
+				}
+				if (!filtered)
+				{
+					candidates = it->second;
+					filtered = true;
+				}
+				else
+				{
+					vector<int> intersection;
+					std::set_intersection(candidates.begin(), candidates.end(), it->second.begin(), it->second.end(), std::back_inserter(intersection));
+					candidates.swap(intersection);
+				}
+				if (candidates.empty())
+				{
+					return this->matches;
+				}
+			}
+		}
+		if (!filtered)
+		{
+			// Only short words, check every node.
+			candidates.resize(this->nodes.size());
+			for (size_t i = 0; i < candidates.size(); ++i)
+			{
+				candidates[i] = i;
+			}
+		}
+
+		// Trigrams can match out of order, check the actual words.
+		for (auto index : candidates)
+		{
+			const auto & node = this->nodes[index];
+			if (!node.alive)
+			{
+				continue;
+			}
+			auto match = true;
+			for (const auto & word : words)
+			{
+				if (node.lowerPath.find(word) == string::npos)
+				{
+					match = false;
+					break;
+				}
+			}
+			if (!match)
+			{
+				continue;
+			}
+
+			this->matches.push_back(index);
+
+			// Show the way down to the match.
+			for (auto current = index; current >= 0 && this->visibleStamps[current] != this->stamp; current = this->nodes[current].parent)
+			{
+				this->visibleStamps[current] = this->stamp;
+			}
+		}
+
+		return this->matches;
+	}
+
+	//--------------------------------------------------------------
+	const string & SearchIndex::getQuery() const
+	{
+		return this->query;
+	}
+
+	//--------------------------------------------------------------
+	bool SearchIndex::isVisible(int index) const
+	{
+		return index >= 0 && index < static_cast<int>(this->visibleStamps.size()) && this->visibleStamps[index] == this->stamp;
+	}
+
+	//--------------------------------------------------------------
+	const SearchIndex::Node & SearchIndex::operator[](size_t index) const
+	{
+		return this->nodes[index];
+	}
+
+	//--------------------------------------------------------------
+	size_t SearchIndex::size() const
+	{
+		return this->nodes.size();
+	}
+
+	//--------------------------------------------------------------
+	ofParameterGroup & SearchIndex::getGroup()
+	{
+		return this->group;
+	}
+
+	//--------------------------------------------------------------
+	int SearchIndex::addNode(const shared_ptr<ofAbstractParameter> & parameter, const string & path, int parent)
+	{
+		const auto index = static_cast<int>(this->nodes.size());
+
+		Node node;
+		node.parameter = parameter;
+		node.name = parameter->getName();
+		node.path = path;
+		node.lowerPath = ofToLower(path);
+		node.parent = parent;
+		node.isGroup = (dynamic_pointer_cast<ofParameterGroup>(parameter) != nullptr);
+		node.alive = true;
+		this->nodes.push_back(std::move(node));
+
+		// Node indices only grow, so the posting lists stay sorted.
+		const auto & lowerPath = this->nodes.back().lowerPath;
+		for (size_t i = 0; i + 3 <= lowerPath.size(); ++i)
+		{
+			auto & posting = this->postings[GetTrigram(lowerPath.c_str() + i)];
+			if (posting.empty() || posting.back() != index)
+			{
+				posting.push_back(index);
+			}
+		}
+
+		return index;
+	}
+
+	//--------------------------------------------------------------
+	bool SearchIndex::haveChildrenChanged(int index) const
+	{
+		// Compare by identity and name, a group can swap or rename children and keep their count.
+		const auto & children = this->nodes[index].children;
+		auto child = children.begin();
+		for (const auto & parameter : this->nodes[index].parameter->castGroup())
+		{
+			if (!parameter)
+			{
+				continue;
+			}
+			if (child == children.end())
+			{
+				return true;
+			}
+
+			const auto & node = this->nodes[*child];
+			if (node.parameter != parameter || node.name != parameter->getName())
+			{
+				return true;
+			}
+			++child;
+		}
+		return child != children.end();
+	}
+
+	//--------------------------------------------------------------
+	void SearchIndex::addChildren(int index)
+	{
+		auto & group = this->nodes[index].parameter->castGroup();
+
+		const auto path = this->nodes[index].path;
+		for (const auto & parameter : group)
+		{
+			if (!parameter)
+			{
+				continue;
+			}
+
+			const auto child = this->addNode(parameter, path + "/" + parameter->getName(), index);
+			this->nodes[index].children.push_back(child);
+
+			// Group.
+			if (this->nodes[child].isGroup)
+			{
+				// Recurse through contents.
+				this->addChildren(child);
+			}
+		}
+	}
+
+	//--------------------------------------------------------------
+	void SearchIndex::removeChildren(int index)
+	{
+		// Dead nodes are skipped by searches until the next rebuild.
+		for (auto child : this->nodes[index].children)
+		{
+			this->removeChildren(child);
+			this->nodes[child].alive = false;
+			this->nodes[child].parameter.reset();
+			++this->numDead;
+		}
+		this->nodes[index].children.clear();
+	}
+
+	//--------------------------------------------------------------
+	void SearchIndex::rebuild()
+	{
+		auto group = this->group;
+		const auto query = this->query;
+		this->setup(group);
+		this->search(query);
+	}
+}
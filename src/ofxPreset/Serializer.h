@@ -1,9 +1,15 @@
 #pragma once
 
+#include <future>
+
 #include "ofEasyCam.h"
 #include "ofJson.h"
 #include "ofParameter.h"
 
+#include "Expressions.h"
+#include "Modulation.h"
+#include "Transaction.h"
+
 namespace ofxPreset
 {
 	class Serializer
@@ -16,9 +22,36 @@ namespace ofxPreset
 
 		static inline nlohmann::json & Serialize(nlohmann::json & json, const ofAbstractParameter & parameter);
 		static inline const nlohmann::json & Deserialize(const nlohmann::json & json, ofAbstractParameter & parameter);
+		static inline const nlohmann::json & Deserialize(const nlohmann::json & json, ofAbstractParameter & parameter, Transaction & transaction);
 
 		static inline nlohmann::json & Serialize(nlohmann::json & json, const ofParameterGroup & group);
+		// Applies all values in a single Transaction, so listeners only run once everything is set.
+		// Unchanged values are skipped, pass a Transaction to find out which parameters changed.
 		static inline const nlohmann::json & Deserialize(const nlohmann::json & json, ofParameterGroup & group);
+		static inline const nlohmann::json & Deserialize(const nlohmann::json & json, ofParameterGroup & group, Transaction & transaction);
+
+		// Writes the same text as Serialize() followed by dump(indent), straight to the stream without building a json tree.
+		// A negative indent writes compact output.
+		static inline bool Serialize(ostream & os, const ofParameterGroup & group, int indent = 4);
+		static inline bool SerializeToFile(const string & filePath, const ofParameterGroup & group, int indent = 4);
+
+		// Loads the group from the value at path in the file, e.g. "/App/Mesh".
+		// Everything around it is skipped over without being parsed.
+		static inline bool DeserializeFromFile(const string & filePath, const string & path, ofParameterGroup & group);
+		static inline bool DeserializeFromFile(const string & filePath, const string & path, ofParameterGroup & group, Transaction & transaction);
+
+		// Loads the group from a JSON file, keeping a binary cache of the loaded values next to it (filePath + ".cache").
+		// When neither the file contents nor the group layout changed, the values are applied from the cache without parsing.
+		static inline bool DeserializeCached(const string & filePath, ofParameterGroup & group);
+		static inline bool DeserializeCached(const string & filePath, ofParameterGroup & group, Transaction & transaction);
+
+		// Finds the text of the value at path in a JSON document, skipping over the other values.
+		static inline bool FindJsonValue(const char * begin, const char * end, const string & path, const char *& valueBegin, const char *& valueEnd);
+
+		// Same as Deserialize(), but the values of large groups are parsed on numThreads threads (0 uses all cores).
+		// Values are still applied in order on the calling thread, so listeners run in the same order.
+		static inline const nlohmann::json & DeserializeParallel(const nlohmann::json & json, ofParameterGroup & group, size_t numThreads = 0);
+		static inline const nlohmann::json & DeserializeParallel(const nlohmann::json & json, ofParameterGroup & group, Transaction & transaction, size_t numThreads = 0);
 
 		static inline nlohmann::json & Serialize(nlohmann::json & json, const ofEasyCam & easyCam, const string & name = "");
 		static inline const nlohmann::json & Deserialize(const nlohmann::json & json, ofEasyCam & easyCam, const string & name = "");
@@ -28,6 +61,62 @@ namespace ofxPreset
 
 		static inline nlohmann::json & Serialize(nlohmann::json & json, const ofNode & node, const string & name = "");
 		static inline const nlohmann::json & Deserialize(const nlohmann::json & json, ofNode & node, const string & name = "");
+
+		// Expressions as a map of target paths to expression strings.
+		static inline nlohmann::json & Serialize(nlohmann::json & json, const Expressions & expressions, const string & name = "");
+		static inline const nlohmann::json & Deserialize(const nlohmann::json & json, Expressions & expressions, const string & name = "");
+
+		// Batch of nodes stored as packed arrays: the index of each node's parent in the list (kNoParent if it has none,
+		// kExternalParent if it is not in the list, which leaves the current parent alone when loading),
+		// and the local position, orientation and scale of each node. The list must hold the same number of nodes when loading,
+		// and nothing is loaded if the parents would form a cycle.
+		static inline nlohmann::json & SerializeNodes(nlohmann::json & json, const vector<ofNode *> & nodes, const string & name = "");
+		static inline const nlohmann::json & DeserializeNodes(const nlohmann::json & json, const vector<ofNode *> & nodes, const string & name = "");
+
+		// Same as above, as raw binary arrays.
+		static inline bool SerializeNodesToFile(const string & filePath, const vector<ofNode *> & nodes);
+		static inline bool DeserializeNodesFromFile(const string & filePath, const vector<ofNode *> & nodes);
+
+		static const uint32_t kNodesMagic = 0x4e50464f; // "OFPN"
+		static const uint32_t kCacheMagic = 0x4350464f; // "OFPC"
+		static const size_t kNodeTransformSize = 10;
+		static const int32_t kNoParent = -1;
+		static const int32_t kExternalParent = -2;
+
+	protected:
+		struct ParsedValue
+		{
+			shared_ptr<ofAbstractParameter> parameter;
+			Binding::Type type;
+			const string * valueString;
+			float values[Binding::kMaxComponents];
+			bool parsed;
+		};
+
+		static inline void CollectValues(const nlohmann::json & json, ofParameterGroup & group, vector<ParsedValue> & parsedValues);
+
+		// A key of a streamed object, either a parameter or the groups merged under that name.
+		struct StreamEntry
+		{
+			const ofAbstractParameter * parameter;
+			vector<const ofParameterGroup *> groups;
+		};
+
+		static inline void CollectCachedBindings(const nlohmann::json & json, const ofParameterGroup & group, const Bindings & bindings, vector<size_t> & indices);
+		static inline bool ReadCache(const string & cachePath, uint64_t fileHash, const Bindings & bindings, Transaction & transaction);
+		static inline bool WriteCache(const string & cachePath, uint64_t fileHash, const Bindings & bindings, const vector<size_t> & indices);
+
+		static inline void PackNodes(const vector<ofNode *> & nodes, vector<int32_t> & parents, vector<float> & transforms);
+		// Returns false and leaves the nodes alone if the parents are out of range or do not form a forest.
+		static inline bool UnpackNodes(const vector<ofNode *> & nodes, const int32_t * parents, const float * transforms);
+
+		static inline const char * SkipJsonWhitespace(const char * str, const char * end);
+		static inline const char * SkipJsonString(const char * str, const char * end);
+		static inline const char * SkipJsonValue(const char * str, const char * end);
+
+		static inline void CollectStreamEntries(const ofParameterGroup & group, map<string, StreamEntry> & entries);
+		static inline void WriteStreamEntries(ostream & os, const map<string, StreamEntry> & entries, int indent, int level);
+		static inline void WriteStreamString(ostream & os, const string & str);
 	};
 }
 
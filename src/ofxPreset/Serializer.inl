@@ -49,7 +49,7 @@ namespace ofxPreset
 		if (parameter.isSerializable())
 		{
 			const auto name = parameter.getName();
-			json[name] = parameter.toString();
+			json[name] = Modulation::GetBaseString(parameter);
 		}
 
 		return json;
@@ -66,7 +66,27 @@ namespace ofxPreset
 				string valueString = json[name];
 				if (!valueString.empty())
 				{
-					parameter.fromString(valueString);
+					// Skip no-op assignments, they would needlessly fire all listeners.
+					Binding::FromString(parameter, Binding::GetType(parameter), valueString);
+				}
+			}
+		}
+
+		return json;
+	}
+
+	//--------------------------------------------------------------
+	inline const nlohmann::json & Serializer::Deserialize(const nlohmann::json & json, ofAbstractParameter & parameter, Transaction & transaction)
+	{
+		if (parameter.isSerializable())
+		{
+			const auto name = parameter.getName();
+			if (json.count(name))
+			{
+				string valueString = json[name];
+				if (!valueString.empty())
+				{
+					transaction.set(parameter, valueString);
 				}
 			}
 		}
@@ -110,6 +130,15 @@ namespace ofxPreset
 
 	//--------------------------------------------------------------
 	const nlohmann::json & Serializer::Deserialize(const nlohmann::json & json, ofParameterGroup & group)
+	{
+		Transaction transaction(group);
+		const auto & jsonGroup = Serializer::Deserialize(json, group, transaction);
+		transaction.commit();
+		return jsonGroup;
+	}
+
+	//--------------------------------------------------------------
+	const nlohmann::json & Serializer::Deserialize(const nlohmann::json & json, ofParameterGroup & group, Transaction & transaction)
 	{
 		if (group.isSerializable())
 		{
@@ -133,7 +162,7 @@ namespace ofxPreset
 				if (parameterGroup)
 				{
 					// Recurse through contents.
-					Serializer::Deserialize(jsonGroup, *parameterGroup);
+					Serializer::Deserialize(jsonGroup, *parameterGroup, transaction);
 					continue;
 				}
 
@@ -141,7 +170,7 @@ namespace ofxPreset
 				auto parameterAbstract = dynamic_pointer_cast<ofAbstractParameter>(parameter);
 				if (parameterAbstract)
 				{
-					Serializer::Deserialize(jsonGroup, *parameterAbstract);
+					Serializer::Deserialize(jsonGroup, *parameterAbstract, transaction);
 				}
 			}
 
@@ -152,6 +181,552 @@ namespace ofxPreset
 		return json;
 	}
 
+	//--------------------------------------------------------------
+	bool Serializer::Serialize(ostream & os, const ofParameterGroup & group, int indent)
+	{
+		// Same layout as Serialize(json, group): a named group is the only key of the root object,
+		// an unnamed one is the root itself, and anything that ends up empty is null.
+		map<string, StreamEntry> entries;
+		if (!group.isSerializable())
+		{
+			ofLogWarning(__FUNCTION__) << "Group " << group.getName() << " is not serializable";
+		}
+		else if (group.getName().empty())
+		{
+			Serializer::CollectStreamEntries(group, entries);
+		}
+		else
+		{
+			auto & entry = entries[group.getName()];
+			entry.parameter = nullptr;
+			entry.groups.push_back(&group);
+		}
+
+		Serializer::WriteStreamEntries(os, entries, indent, 0);
+		return os.good();
+	}
+
+	//--------------------------------------------------------------
+	bool Serializer::SerializeToFile(const string & filePath, const ofParameterGroup & group, int indent)
+	{
+		std::ofstream file(ofToDataPath(filePath, true), std::ios::binary);
+		if (!file)
+		{
+			ofLogError(__FUNCTION__) << "Could not open " << filePath << " for writing";
+			return false;
+		}
+		return Serializer::Serialize(file, group, indent);
+	}
+
+	//--------------------------------------------------------------
+	void Serializer::CollectStreamEntries(const ofParameterGroup & group, map<string, StreamEntry> & entries)
+	{
+		for (const auto & parameter : group)
+		{
+			if (!parameter)
+			{
+				continue;
+			}
+
+			// Group.
+			auto parameterGroup = dynamic_pointer_cast<ofParameterGroup>(parameter);
+			if (parameterGroup)
+			{
+				if (!parameterGroup->isSerializable())
+				{
+					ofLogWarning(__FUNCTION__) << "Group " << parameterGroup->getName() << " is not serializable";
+				}
+				else if (parameterGroup->getName().empty())
+				{
+					// Unnamed groups are merged into their parent.
+					Serializer::CollectStreamEntries(*parameterGroup, entries);
+				}
+				else
+				{
+					auto & entry = entries[parameterGroup->getName()];
+					entry.parameter = nullptr;
+					entry.groups.push_back(parameterGroup.get());
+				}
+				continue;
+			}
+
+			// Parameter, replaces anything with the same name.
+			if (parameter->isSerializable())
+			{
+				auto & entry = entries[parameter->getName()];
+				entry.parameter = parameter.get();
+				entry.groups.clear();
+			}
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Serializer::WriteStreamEntries(ostream & os, const map<string, StreamEntry> & entries, int indent, int level)
+	{
+		if (entries.empty())
+		{
+			os << "null";
+			return;
+		}
+
+		const auto pretty = (indent >= 0);
+		os << (pretty ? "{\n" : "{");
+
+		auto first = true;
+		for (const auto & it : entries)
+		{
+			if (!first)
+			{
+				os << (pretty ? ",\n" : ",");
+			}
+			first = false;
+
+			if (pretty)
+			{
+				os << string(indent * (level + 1), ' ');
+			}
+			Serializer::WriteStreamString(os, it.first);
+			os << (pretty ? ": " : ":");
+
+			const auto & entry = it.second;
+			if (entry.parameter)
+			{
+				Serializer::WriteStreamString(os, Modulation::GetBaseString(*entry.parameter));
+			}
+			else
+			{
+				// Only one level of entries is alive at a time per depth, never the whole tree.
+				map<string, StreamEntry> children;
+				for (auto childGroup : entry.groups)
+				{
+					Serializer::CollectStreamEntries(*childGroup, children);
+				}
+				Serializer::WriteStreamEntries(os, children, indent, level + 1);
+			}
+		}
+
+		if (pretty)
+		{
+			os << '\n' << string(indent * level, ' ');
+		}
+		os << '}';
+	}
+
+	//--------------------------------------------------------------
+	void Serializer::WriteStreamString(ostream & os, const string & str)
+	{
+		// Same escaping as nlohmann::json::dump().
+		os << '"';
+		for (const auto c : str)
+		{
+			switch (c)
+			{
+			case '"': os << "\\\""; break;
+			case '\\': os << "\\\\"; break;
+			case '\b': os << "\\b"; break;
+			case '\f': os << "\\f"; break;
+			case '\n': os << "\\n"; break;
+			case '\r': os << "\\r"; break;
+			case '\t': os << "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+				{
+					char escaped[7];
+					snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+					os << escaped;
+				}
+				else
+				{
+					os << c;
+				}
+				break;
+			}
+		}
+		os << '"';
+	}
+
+	//--------------------------------------------------------------
+	bool Serializer::DeserializeFromFile(const string & filePath, const string & path, ofParameterGroup & group)
+	{
+		Transaction transaction(group);
+		const auto result = Serializer::DeserializeFromFile(filePath, path, group, transaction);
+		transaction.commit();
+		return result;
+	}
+
+	//--------------------------------------------------------------
+	bool Serializer::DeserializeFromFile(const string & filePath, const string & path, ofParameterGroup & group, Transaction & transaction)
+	{
+		std::ifstream file(ofToDataPath(filePath, true), std::ios::binary);
+		if (!file)
+		{
+			ofLogWarning(__FUNCTION__) << "File " << filePath << " not found!";
+			return false;
+		}
+		const string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		const char * valueBegin;
+		const char * valueEnd;
+		if (!Serializer::FindJsonValue(text.data(), text.data() + text.size(), path, valueBegin, valueEnd))
+		{
+			ofLogWarning(__FUNCTION__) << "Path " << path << " not found in " << filePath << "!";
+			return false;
+		}
+
+		// Only the requested value is parsed.
+		nlohmann::json json;
+		try
+		{
+			auto value = nlohmann::json::parse(valueBegin, valueEnd);
+			if (group.getName().empty())
+			{
+				json = std::move(value);
+			}
+			else
+			{
+				json[group.getName()] = std::move(value);
+			}
+		}
+		catch (const std::exception & e)
+		{
+			ofLogError(__FUNCTION__) << "Could not parse " << path << " in " << filePath << ": " << e.what();
+			return false;
+		}
+
+		Serializer::Deserialize(json, group, transaction);
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	bool Serializer::DeserializeCached(const string & filePath, ofParameterGroup & group)
+	{
+		Transaction transaction(group);
+		const auto success = Serializer::DeserializeCached(filePath, group, transaction);
+		transaction.commit();
+		return success;
+	}
+
+	//--------------------------------------------------------------
+	bool Serializer::DeserializeCached(const string & filePath, ofParameterGroup & group, Transaction & transaction)
+	{
+		const auto jsonPath = ofToDataPath(filePath, true);
+		std::ifstream file(jsonPath, std::ios::binary);
+		if (!file)
+		{
+			ofLogWarning(__FUNCTION__) << "File " << filePath << " not found!";
+			return false;
+		}
+		const string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		// Hashing the text is much cheaper than parsing it.
+		const auto fileHash = Bindings::Hash(text);
+		const auto cachePath = jsonPath + ".cache";
+		const Bindings bindings(group);
+		if (Serializer::ReadCache(cachePath, fileHash, bindings, transaction))
+		{
+			return true;
+		}
+
+		nlohmann::json json;
+		try
+		{
+			json = nlohmann::json::parse(text);
+		}
+		catch (const std::exception & e)
+		{
+			ofLogError(__FUNCTION__) << "Could not parse " << filePath << ": " << e.what();
+			return false;
+		}
+
+		Serializer::Deserialize(json, group, transaction);
+
+		// Only cache the values found in the file, the others keep whatever value they had.
+		vector<size_t> indices;
+		Serializer::CollectCachedBindings(json, group, bindings, indices);
+		Serializer::WriteCache(cachePath, fileHash, bindings, indices);
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	bool Serializer::FindJsonValue(const char * begin, const char * end, const string & path, const char *& valueBegin, const char *& valueEnd)
+	{
+		auto str = SkipJsonWhitespace(begin, end);
+		for (const auto & segment : ofSplitString(path, "/", true))
+		{
+			if (str == end || *str != '{')
+			{
+				return false;
+			}
+			str = SkipJsonWhitespace(str + 1, end);
+
+			// Walk the keys of this object until the segment is found.
+			auto found = false;
+			while (!found)
+			{
+				if (str == end || *str != '"')
+				{
+					return false;
+				}
+				const auto keyBegin = str;
+				str = SkipJsonString(str, end);
+				if (!str)
+				{
+					return false;
+				}
+
+				string key(keyBegin + 1, str - 1);
+				if (key.find('\\') != string::npos)
+				{
+					// Let the parser deal with escapes, keys are short.
+					try
+					{
+						key = nlohmann::json::parse(keyBegin, str).get<string>();
+					}
+					catch (const std::exception & e)
+					{
+						ofLogWarning(__FUNCTION__) << "Invalid key " << string(keyBegin, str) << ": " << e.what();
+						return false;
+					}
+				}
+
+				str = SkipJsonWhitespace(str, end);
+				if (str == end || *str != ':')
+				{
+					return false;
+				}
+				str = SkipJsonWhitespace(str + 1, end);
+
+				if (key == segment)
+				{
+					found = true;
+					continue;
+				}
+
+				str = SkipJsonValue(str, end);
+				if (!str)
+				{
+					return false;
+				}
+				str = SkipJsonWhitespace(str, end);
+				if (str == end || *str != ',')
+				{
+					// End of the object.
+					return false;
+				}
+				str = SkipJsonWhitespace(str + 1, end);
+			}
+		}
+
+		valueBegin = str;
+		valueEnd = SkipJsonValue(str, end);
+		return valueEnd != nullptr;
+	}
+
+	//--------------------------------------------------------------
+	const char * Serializer::SkipJsonWhitespace(const char * str, const char * end)
+	{
+		while (str != end && (*str == ' ' || *str == '\t' || *str == '\n' || *str == '\r'))
+		{
+			++str;
+		}
+		return str;
+	}
+
+	//--------------------------------------------------------------
+	const char * Serializer::SkipJsonString(const char * str, const char * end)
+	{
+		// Starts on the opening quote, returns past the closing one.
+		for (++str; str < end; ++str)
+		{
+			if (*str == '\\')
+			{
+				++str;
+			}
+			else if (*str == '"')
+			{
+				return str + 1;
+			}
+		}
+		return nullptr;
+	}
+
+	//--------------------------------------------------------------
+	const char * Serializer::SkipJsonValue(const char * str, const char * end)
+	{
+		if (str == end)
+		{
+			return nullptr;
+		}
+		if (*str == '"')
+		{
+			return SkipJsonString(str, end);
+		}
+		if (*str == '{' || *str == '[')
+		{
+			// Only count the brackets, strings may contain any of them.
+			int depth = 0;
+			while (str < end)
+			{
+				if (*str == '"')
+				{
+					str = SkipJsonString(str, end);
+					if (!str)
+					{
+						return nullptr;
+					}
+					continue;
+				}
+				if (*str == '{' || *str == '[')
+				{
+					++depth;
+				}
+				else if (*str == '}' || *str == ']')
+				{
+					if (--depth == 0)
+					{
+						return str + 1;
+					}
+				}
+				++str;
+			}
+			return nullptr;
+		}
+
+		// Number or literal.
+		while (str != end && *str != ',' && *str != '}' && *str != ']' && *str != ' ' && *str != '\t' && *str != '\n' && *str != '\r')
+		{
+			++str;
+		}
+		return str;
+	}
+
+	//--------------------------------------------------------------
+	const nlohmann::json & Serializer::DeserializeParallel(const nlohmann::json & json, ofParameterGroup & group, size_t numThreads)
+	{
+		Transaction transaction(group);
+		const auto & jsonGroup = Serializer::DeserializeParallel(json, group, transaction, numThreads);
+		transaction.commit();
+		return jsonGroup;
+	}
+
+	//--------------------------------------------------------------
+	const nlohmann::json & Serializer::DeserializeParallel(const nlohmann::json & json, ofParameterGroup & group, Transaction & transaction, size_t numThreads)
+	{
+		// Match the values to their parameters.
+		vector<ParsedValue> parsedValues;
+		Serializer::CollectValues(json, group, parsedValues);
+
+		// Parse the floating point values, which is where most of the time goes.
+		auto parse = [&parsedValues](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				auto & parsedValue = parsedValues[i];
+				if (parsedValue.type != Binding::Type::Bool && parsedValue.type != Binding::Type::Int)
+				{
+					const auto count = Binding::GetNumComponents(parsedValue.type);
+					parsedValue.parsed = count && Binding::ParseComponents(*parsedValue.valueString, parsedValue.values, count);
+				}
+			}
+		};
+
+		// Not worth spinning up threads for small groups.
+		static const size_t kMinValuesPerThread = 1024;
+		if (numThreads == 0)
+		{
+			numThreads = std::max(1u, std::thread::hardware_concurrency());
+		}
+		numThreads = std::max<size_t>(1, std::min(numThreads, parsedValues.size() / kMinValuesPerThread));
+
+		const auto chunkSize = (parsedValues.size() + numThreads - 1) / numThreads;
+		vector<std::future<void>> futures;
+		for (size_t i = 1; i < numThreads; ++i)
+		{
+			const auto begin = std::min(i * chunkSize, parsedValues.size());
+			const auto end = std::min(begin + chunkSize, parsedValues.size());
+			futures.push_back(std::async(std::launch::async, parse, begin, end));
+		}
+		parse(0, std::min(chunkSize, parsedValues.size()));
+		for (auto & future : futures)
+		{
+			future.wait();
+		}
+
+		// Apply in order.
+		for (const auto & parsedValue : parsedValues)
+		{
+			if (parsedValue.parsed)
+			{
+				transaction.set(*parsedValue.parameter, parsedValue.type, parsedValue.values);
+			}
+			else
+			{
+				transaction.set(*parsedValue.parameter, *parsedValue.valueString);
+			}
+		}
+
+		const auto name = group.getName();
+		return (name.empty() || !json.count(name)) ? json : json[name];
+	}
+
+	//--------------------------------------------------------------
+	void Serializer::CollectValues(const nlohmann::json & json, ofParameterGroup & group, vector<ParsedValue> & parsedValues)
+	{
+		if (!group.isSerializable())
+		{
+			ofLogWarning(__FUNCTION__) << "Group " << group.getName() << " is not serializable";
+			return;
+		}
+
+		const auto name = group.getName();
+		if (!name.empty() && !json.count(name))
+		{
+			ofLogWarning(__FUNCTION__) << "Name " << name << " not found in JSON!";
+			return;
+		}
+
+		const auto & jsonGroup = name.empty() ? json : json[name];
+		for (const auto & parameter : group)
+		{
+			if (!parameter)
+			{
+				continue;
+			}
+
+			// Group.
+			auto parameterGroup = dynamic_pointer_cast<ofParameterGroup>(parameter);
+			if (parameterGroup)
+			{
+				// Recurse through contents.
+				Serializer::CollectValues(jsonGroup, *parameterGroup, parsedValues);
+				continue;
+			}
+
+			// Parameter.
+			if (!parameter->isSerializable())
+			{
+				continue;
+			}
+			const auto it = jsonGroup.find(parameter->getName());
+			if (it == jsonGroup.end() || !it->is_string())
+			{
+				continue;
+			}
+			const auto & valueString = it->get_ref<const string &>();
+			if (valueString.empty())
+			{
+				continue;
+			}
+
+			ParsedValue parsedValue;
+			parsedValue.parameter = parameter;
+			parsedValue.type = Binding::GetType(*parameter);
+			parsedValue.valueString = &valueString;
+			parsedValue.parsed = false;
+			parsedValues.push_back(parsedValue);
+		}
+	}
+
 	//--------------------------------------------------------------
 	inline nlohmann::json & Serializer::Serialize(nlohmann::json & json, const ofEasyCam & easyCam, const string & name)
 	{
@@ -306,4 +881,492 @@ namespace ofxPreset
 
 		return jsonGroup;
 	}
+
+	//--------------------------------------------------------------
+	inline nlohmann::json & Serializer::Serialize(nlohmann::json & json, const Expressions & expressions, const string & name)
+	{
+		auto & jsonGroup = name.empty() ? json : json[name];
+
+		for (size_t i = 0; i < expressions.size(); ++i)
+		{
+			jsonGroup[expressions.getTarget(i)] = expressions.getExpression(i);
+		}
+
+		return jsonGroup;
+	}
+
+	//--------------------------------------------------------------
+	inline const nlohmann::json & Serializer::Deserialize(const nlohmann::json & json, Expressions & expressions, const string & name)
+	{
+		if (!name.empty() && !json.count(name))
+		{
+			ofLogWarning(__FUNCTION__) << "Name " << name << " not found in JSON!";
+			return json;
+		}
+
+		const auto & jsonGroup = name.empty() ? json : json[name];
+
+		// Remove the expressions missing from the JSON, then set the others (set() logs any that fail).
+		for (int i = static_cast<int>(expressions.size()) - 1; i >= 0; --i)
+		{
+			const auto target = expressions.getTarget(i);
+			if (!jsonGroup.count(target))
+			{
+				expressions.remove(target);
+			}
+		}
+		for (auto it = jsonGroup.begin(); it != jsonGroup.end(); ++it)
+		{
+			if (it->is_string())
+			{
+				expressions.set(it.key(), it->get<string>());
+			}
+		}
+
+		return jsonGroup;
+	}
+
+	//--------------------------------------------------------------
+	inline nlohmann::json & Serializer::SerializeNodes(nlohmann::json & json, const vector<ofNode *> & nodes, const string & name)
+	{
+		auto & jsonGroup = name.empty() ? json : json[name];
+
+		vector<int32_t> parents;
+		vector<float> transforms;
+		PackNodes(nodes, parents, transforms);
+
+		jsonGroup["parents"] = parents;
+		jsonGroup["transforms"] = transforms;
+
+		return jsonGroup;
+	}
+
+	//--------------------------------------------------------------
+	inline const nlohmann::json & Serializer::DeserializeNodes(const nlohmann::json & json, const vector<ofNode *> & nodes, const string & name)
+	{
+		if (!name.empty() && !json.count(name))
+		{
+			ofLogWarning(__FUNCTION__) << "Name " << name << " not found in JSON!";
+			return json;
+		}
+
+		const auto & jsonGroup = name.empty() ? json : json[name];
+
+		try
+		{
+			const auto parents = jsonGroup.at("parents").get<vector<int32_t>>();
+			const auto transforms = jsonGroup.at("transforms").get<vector<float>>();
+			if (parents.size() != nodes.size() || transforms.size() != nodes.size() * kNodeTransformSize)
+			{
+				ofLogError(__FUNCTION__) << "Expected " << nodes.size() << " nodes, found " << parents.size() << "!";
+				return jsonGroup;
+			}
+			if (!UnpackNodes(nodes, parents.data(), transforms.data()))
+			{
+				ofLogError(__FUNCTION__) << "Node parents are out of range or form a cycle!";
+			}
+		}
+		catch (std::exception & exc)
+		{
+			ofLogError(__FUNCTION__) << exc.what();
+		}
+
+		return jsonGroup;
+	}
+
+	//--------------------------------------------------------------
+	inline bool Serializer::SerializeNodesToFile(const string & filePath, const vector<ofNode *> & nodes)
+	{
+		vector<int32_t> parents;
+		vector<float> transforms;
+		PackNodes(nodes, parents, transforms);
+
+		std::ofstream file(ofToDataPath(filePath, true), std::ios::binary);
+		if (!file)
+		{
+			ofLogError(__FUNCTION__) << "Could not open " << filePath << " for writing!";
+			return false;
+		}
+
+		const auto magic = kNodesMagic;
+		const auto count = static_cast<uint32_t>(nodes.size());
+		file.write(reinterpret_cast<const char *>(&magic), sizeof(magic));
+		file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+		file.write(reinterpret_cast<const char *>(parents.data()), parents.size() * sizeof(int32_t));
+		file.write(reinterpret_cast<const char *>(transforms.data()), transforms.size() * sizeof(float));
+		return file.good();
+	}
+
+	//--------------------------------------------------------------
+	inline bool Serializer::DeserializeNodesFromFile(const string & filePath, const vector<ofNode *> & nodes)
+	{
+		std::ifstream file(ofToDataPath(filePath, true), std::ios::binary);
+		if (!file)
+		{
+			ofLogWarning(__FUNCTION__) << "Could not open " << filePath << "!";
+			return false;
+		}
+
+		uint32_t magic = 0;
+		uint32_t count = 0;
+		file.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+		file.read(reinterpret_cast<char *>(&count), sizeof(count));
+		if (!file || magic != kNodesMagic)
+		{
+			ofLogError(__FUNCTION__) << "File " << filePath << " does not contain nodes!";
+			return false;
+		}
+		if (count != nodes.size())
+		{
+			ofLogError(__FUNCTION__) << "Expected " << nodes.size() << " nodes, found " << count << "!";
+			return false;
+		}
+
+		vector<int32_t> parents(count);
+		vector<float> transforms(count * kNodeTransformSize);
+		file.read(reinterpret_cast<char *>(parents.data()), parents.size() * sizeof(int32_t));
+		file.read(reinterpret_cast<char *>(transforms.data()), transforms.size() * sizeof(float));
+		if (!file)
+		{
+			ofLogError(__FUNCTION__) << "File " << filePath << " is truncated!";
+			return false;
+		}
+
+		if (!UnpackNodes(nodes, parents.data(), transforms.data()))
+		{
+			ofLogError(__FUNCTION__) << "Node parents in " << filePath << " are out of range or form a cycle!";
+			return false;
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	void Serializer::CollectCachedBindings(const nlohmann::json & json, const ofParameterGroup & group, const Bindings & bindings, vector<size_t> & indices)
+	{
+		if (!group.isSerializable())
+		{
+			return;
+		}
+
+		// Same lookups as Deserialize().
+		const auto name = group.getName();
+		if (!name.empty() && !json.count(name))
+		{
+			return;
+		}
+
+		const auto & jsonGroup = name.empty() ? json : json[name];
+		for (const auto & parameter : group)
+		{
+			if (!parameter)
+			{
+				continue;
+			}
+
+			// Group.
+			auto parameterGroup = dynamic_pointer_cast<ofParameterGroup>(parameter);
+			if (parameterGroup)
+			{
+				// Recurse through contents.
+				Serializer::CollectCachedBindings(jsonGroup, *parameterGroup, bindings, indices);
+				continue;
+			}
+
+			// Parameter.
+			const auto it = jsonGroup.find(parameter->getName());
+			if (!parameter->isSerializable() || it == jsonGroup.end() || !it->is_string() || it->get_ref<const string &>().empty())
+			{
+				continue;
+			}
+			const auto index = bindings.indexOf(*parameter);
+			if (index >= 0)
+			{
+				indices.push_back(index);
+			}
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool Serializer::ReadCache(const string & cachePath, uint64_t fileHash, const Bindings & bindings, Transaction & transaction)
+	{
+		std::ifstream file(cachePath, std::ios::binary);
+		if (!file)
+		{
+			return false;
+		}
+		const string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		// Header, then the entries, then a hash of everything before it.
+		struct Header
+		{
+			uint32_t magic;
+			uint32_t count;
+			uint64_t fileHash;
+			uint64_t schemaHash;
+		};
+		if (data.size() < sizeof(Header) + sizeof(uint64_t))
+		{
+			return false;
+		}
+
+		Header header;
+		memcpy(&header, data.data(), sizeof(header));
+		uint64_t checksum;
+		const auto payloadSize = data.size() - sizeof(checksum);
+		memcpy(&checksum, data.data() + payloadSize, sizeof(checksum));
+		if (header.magic != kCacheMagic || header.fileHash != fileHash || header.schemaHash != bindings.getSchemaHash()
+			|| checksum != Bindings::Hash(data.data(), payloadSize))
+		{
+			return false;
+		}
+
+		// The checksum matched, so the entries are as written.
+		auto str = data.data() + sizeof(header);
+		const auto end = data.data() + payloadSize;
+		float values[Binding::kMaxComponents];
+		for (uint32_t i = 0; i < header.count; ++i)
+		{
+			uint32_t index;
+			if (str + sizeof(index) > end)
+			{
+				return false;
+			}
+			memcpy(&index, str, sizeof(index));
+			str += sizeof(index);
+			if (index >= bindings.size())
+			{
+				return false;
+			}
+
+			const auto & binding = bindings[index];
+			if (binding.isNumeric())
+			{
+				const auto size = binding.getNumComponents() * sizeof(float);
+				if (str + size > end)
+				{
+					return false;
+				}
+				memcpy(values, str, size);
+				str += size;
+				transaction.set(*binding.parameter, binding.type, values);
+			}
+			else
+			{
+				uint32_t length;
+				if (str + sizeof(length) > end)
+				{
+					return false;
+				}
+				memcpy(&length, str, sizeof(length));
+				str += sizeof(length);
+				if (str + length > end)
+				{
+					return false;
+				}
+				transaction.set(*binding.parameter, string(str, length));
+				str += length;
+			}
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	bool Serializer::WriteCache(const string & cachePath, uint64_t fileHash, const Bindings & bindings, const vector<size_t> & indices)
+	{
+		string data;
+		const auto append = [&data](const void * bytes, size_t size)
+		{
+			data.append(static_cast<const char *>(bytes), size);
+		};
+
+		const auto magic = kCacheMagic;
+		const auto count = static_cast<uint32_t>(indices.size());
+		const auto schemaHash = bindings.getSchemaHash();
+		append(&magic, sizeof(magic));
+		append(&count, sizeof(count));
+		append(&fileHash, sizeof(fileHash));
+		append(&schemaHash, sizeof(schemaHash));
+
+		float values[Binding::kMaxComponents];
+		for (auto index : indices)
+		{
+			const auto & binding = bindings[index];
+			const auto index32 = static_cast<uint32_t>(index);
+			append(&index32, sizeof(index32));
+			if (binding.isNumeric())
+			{
+				if (!Modulation::GetBase(binding, values))
+				{
+					binding.getComponents(values);
+				}
+				append(values, binding.getNumComponents() * sizeof(float));
+			}
+			else
+			{
+				const auto valueString = binding.parameter->toString();
+				const auto length = static_cast<uint32_t>(valueString.size());
+				append(&length, sizeof(length));
+				append(valueString.data(), length);
+			}
+		}
+
+		const auto checksum = Bindings::Hash(data.data(), data.size());
+		append(&checksum, sizeof(checksum));
+
+		// Write to a temporary file first, so a crash never leaves a half written cache behind.
+		const auto tempPath = cachePath + ".tmp";
+		{
+			std::ofstream file(tempPath, std::ios::binary);
+			if (!file || !file.write(data.data(), data.size()))
+			{
+				ofLogWarning(__FUNCTION__) << "Could not write " << cachePath << "!";
+				return false;
+			}
+		}
+		std::remove(cachePath.c_str());
+		if (std::rename(tempPath.c_str(), cachePath.c_str()) != 0)
+		{
+			ofLogWarning(__FUNCTION__) << "Could not write " << cachePath << "!";
+			std::remove(tempPath.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	inline void Serializer::PackNodes(const vector<ofNode *> & nodes, vector<int32_t> & parents, vector<float> & transforms)
+	{
+		unordered_map<const ofNode *, int32_t> indexByNode;
+		indexByNode.reserve(nodes.size());
+		for (size_t i = 0; i < nodes.size(); ++i)
+		{
+			indexByNode[nodes[i]] = static_cast<int32_t>(i);
+		}
+
+		parents.resize(nodes.size());
+		transforms.resize(nodes.size() * kNodeTransformSize);
+		for (size_t i = 0; i < nodes.size(); ++i)
+		{
+			const auto & node = *nodes[i];
+
+			// Parents outside the list are not saved, only flagged so loading keeps them.
+			if (!node.getParent())
+			{
+				parents[i] = kNoParent;
+			}
+			else
+			{
+				const auto it = indexByNode.find(node.getParent());
+				if (it == indexByNode.end())
+				{
+					parents[i] = kExternalParent;
+				}
+				else
+				{
+					parents[i] = it->second;
+				}
+			}
+
+			const auto position = node.getPosition();
+			const auto orientation = node.getOrientationQuat();
+			const auto scale = node.getScale();
+			auto transform = &transforms[i * kNodeTransformSize];
+			transform[0] = position.x;
+			transform[1] = position.y;
+			transform[2] = position.z;
+			transform[3] = orientation.x;
+			transform[4] = orientation.y;
+			transform[5] = orientation.z;
+			transform[6] = orientation.w;
+			transform[7] = scale.x;
+			transform[8] = scale.y;
+			transform[9] = scale.z;
+		}
+	}
+
+	//--------------------------------------------------------------
+	inline bool Serializer::UnpackNodes(const vector<ofNode *> & nodes, const int32_t * parents, const float * transforms)
+	{
+		// Resolve the parent each node ends up with, external ones keep their current parent, which may be in the list too.
+		const auto count = static_cast<int32_t>(nodes.size());
+		vector<int32_t> resolvedParents(count);
+		unordered_map<const ofNode *, int32_t> indexByNode;
+		for (int32_t i = 0; i < count; ++i)
+		{
+			const auto parent = parents[i];
+			if (parent == kExternalParent)
+			{
+				if (indexByNode.empty())
+				{
+					for (int32_t j = 0; j < count; ++j)
+					{
+						indexByNode[nodes[j]] = j;
+					}
+				}
+				const auto it = indexByNode.find(nodes[i]->getParent());
+				if (it != indexByNode.end())
+				{
+					resolvedParents[i] = it->second;
+				}
+				else
+				{
+					resolvedParents[i] = kNoParent;
+				}
+			}
+			else if (parent == kNoParent || (parent >= 0 && parent < count))
+			{
+				resolvedParents[i] = parent;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		// The parents must form a forest, check before touching any node so a bad file changes nothing.
+		const uint8_t kUnvisited = 0;
+		const uint8_t kVisiting = 1;
+		const uint8_t kVisited = 2;
+		vector<uint8_t> states(count, kUnvisited);
+		for (int32_t i = 0; i < count; ++i)
+		{
+			auto current = i;
+			while (current >= 0 && states[current] == kUnvisited)
+			{
+				states[current] = kVisiting;
+				current = resolvedParents[current];
+			}
+			if (current >= 0 && states[current] == kVisiting)
+			{
+				// Walked back into the chain we are on.
+				return false;
+			}
+			for (current = i; current >= 0 && states[current] == kVisiting; current = resolvedParents[current])
+			{
+				states[current] = kVisited;
+			}
+		}
+
+		for (int32_t i = 0; i < count; ++i)
+		{
+			auto & node = *nodes[i];
+
+			// Transforms are local, so parent first without keeping the global transform.
+			const auto parent = parents[i];
+			if (parent >= 0)
+			{
+				node.setParent(*nodes[parent], false);
+			}
+			else if (parent == kNoParent && node.getParent())
+			{
+				node.clearParent(false);
+			}
+
+			const auto transform = transforms + i * kNodeTransformSize;
+			node.setPosition(glm::vec3(transform[0], transform[1], transform[2]));
+			node.setOrientation(glm::quat(transform[6], transform[3], transform[4], transform[5]));
+			node.setScale(glm::vec3(transform[7], transform[8], transform[9]));
+		}
+		return true;
+	}
 }
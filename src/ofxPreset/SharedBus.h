@@ -0,0 +1,90 @@
+#pragma once
+
+#include "ofConstants.h"
+
+#ifdef TARGET_WIN32
+#error "ofxPreset::SharedBus requires POSIX shared memory"
+#endif
+
+#include "Bindings.h"
+
+namespace ofxPreset
+{
+	// Mirrors an ofParameterGroup across processes through POSIX shared memory.
+	// One process creates the bus and writes, any number of processes attach and read.
+	// Every parameter has its own sequence-locked slot, so readers never see torn values
+	// and only pay for the slots that changed since their last update.
+	// The segment is only accessible to the user that created it.
+	class SharedBus
+	{
+	public:
+		static const uint32_t kMagic = 0x53584f46; // "FOXS"
+		static const uint32_t kVersion = 2;
+		static const size_t kMaxStringLength = 256;
+
+		struct Header
+		{
+			// Cleared by the writer before the segment goes away, so readers know to attach again.
+			std::atomic<uint32_t> magic;
+			uint32_t version;
+			uint64_t schemaHash;
+			uint32_t numSlots;
+			uint32_t slotSize;
+			int32_t writerPid;
+			std::atomic<uint64_t> sequence;
+		};
+
+		struct Slot
+		{
+			std::atomic<uint32_t> sequence;
+			uint32_t length;
+			float values[Binding::kMaxComponents];
+			char text[kMaxStringLength];
+		};
+
+		inline SharedBus();
+		inline ~SharedBus();
+
+		// Creates the shared memory segment and publishes every change made to the group.
+		// Fails if another process is still writing to a segment with that name.
+		inline bool create(const string & name, ofParameterGroup & group);
+
+		// Attaches to an existing segment, refusing it if the group layout does not match.
+		inline bool attach(const string & name, ofParameterGroup & group);
+
+		inline void close();
+
+		// Readers: copies every slot that changed since the last call into the group.
+		// Attaches again if the writer closed or replaced the segment, and closes if it is gone.
+		inline size_t update();
+
+		inline bool isWriter() const;
+		inline bool isReader() const;
+
+	protected:
+		// Invalidates and removes a segment left behind by a writer that is gone.
+		// Returns false if its writer is still running.
+		static inline bool ReleaseStale(const string & name);
+
+		inline bool map(const string & name, bool writer);
+		inline Slot & getSlot(size_t index) const;
+		inline void write(size_t index);
+		inline bool read(size_t index);
+
+		Bindings bindings;
+		ofEventListener listener;
+
+		string name;
+		int fd;
+		void * memory;
+		size_t memorySize;
+		bool writer;
+
+		Header * header;
+		uint64_t lastSequence;
+		vector<uint32_t> lastSlotSequences;
+		string text;
+	};
+}
+
+#include "SharedBus.inl"
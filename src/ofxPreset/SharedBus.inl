@@ -0,0 +1,383 @@
+#include "SharedBus.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	SharedBus::SharedBus()
+		: fd(-1)
+		, memory(nullptr)
+		, memorySize(0)
+		, writer(false)
+		, header(nullptr)
+		, lastSequence(0)
+	{}
+
+	//--------------------------------------------------------------
+	SharedBus::~SharedBus()
+	{
+		this->close();
+	}
+
+	//--------------------------------------------------------------
+	bool SharedBus::create(const string & name, ofParameterGroup & group)
+	{
+		this->close();
+
+		this->bindings.setup(group);
+		if (!this->map(name, true))
+		{
+			return false;
+		}
+
+		this->header->version = kVersion;
+		this->header->schemaHash = this->bindings.getSchemaHash();
+		this->header->numSlots = static_cast<uint32_t>(this->bindings.size());
+		this->header->slotSize = sizeof(Slot);
+		this->header->sequence.store(0, std::memory_order_relaxed);
+		for (size_t i = 0; i < this->bindings.size(); ++i)
+		{
+			this->getSlot(i).sequence.store(0, std::memory_order_relaxed);
+			this->write(i);
+		}
+
+		// Publish the segment once it is fully initialized.
+		this->header->magic.store(kMagic, std::memory_order_release);
+
+		this->listener = this->bindings.getGroup().parameterChangedE().newListener([this](ofAbstractParameter & parameter)
+		{
+			const auto index = this->bindings.indexOf(parameter);
+			if (index >= 0)
+			{
+				this->write(index);
+			}
+		});
+
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	bool SharedBus::attach(const string & name, ofParameterGroup & group)
+	{
+		this->close();
+
+		this->bindings.setup(group);
+		if (!this->map(name, false))
+		{
+			return false;
+		}
+
+		if (this->header->magic.load(std::memory_order_acquire) != kMagic || this->header->version != kVersion)
+		{
+			ofLogError(__FUNCTION__) << "Shared memory " << name << " is not a parameter bus";
+			this->close();
+			return false;
+		}
+		if (this->header->schemaHash != this->bindings.getSchemaHash() || this->header->numSlots != this->bindings.size() || this->header->slotSize != sizeof(Slot) || this->memorySize != sizeof(Header) + this->bindings.size() * sizeof(Slot))
+		{
+			ofLogError(__FUNCTION__) << "Shared memory " << name << " was created for a different layout of group " << group.getName();
+			this->close();
+			return false;
+		}
+
+		// Force a full read on the first update.
+		this->lastSequence = std::numeric_limits<uint64_t>::max();
+		this->lastSlotSequences.assign(this->bindings.size(), std::numeric_limits<uint32_t>::max());
+
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	void SharedBus::close()
+	{
+		this->listener.unsubscribe();
+
+		// Let readers know before the segment goes away.
+		if (this->writer && this->header)
+		{
+			this->header->magic.store(0, std::memory_order_release);
+		}
+		if (this->memory)
+		{
+			munmap(this->memory, this->memorySize);
+			this->memory = nullptr;
+			this->header = nullptr;
+		}
+		if (this->fd >= 0)
+		{
+			::close(this->fd);
+			this->fd = -1;
+		}
+		if (this->writer)
+		{
+			shm_unlink(this->name.c_str());
+			this->writer = false;
+		}
+
+		this->memorySize = 0;
+		this->lastSlotSequences.clear();
+	}
+
+	//--------------------------------------------------------------
+	size_t SharedBus::update()
+	{
+		if (!this->isReader())
+		{
+			return 0;
+		}
+
+		// The writer closed or replaced the segment, follow it to the new one if there is any.
+		if (this->header->magic.load(std::memory_order_acquire) != kMagic)
+		{
+			ofLogNotice(__FUNCTION__) << "Shared memory " << this->name << " was closed by its writer, attaching again";
+			const auto name = this->name;
+			auto group = this->bindings.getGroup();
+			if (!this->attach(name, group))
+			{
+				return 0;
+			}
+		}
+
+		// Nothing to do if the writer has not touched any slot.
+		const auto sequence = this->header->sequence.load(std::memory_order_acquire);
+		if (sequence == this->lastSequence)
+		{
+			return 0;
+		}
+		this->lastSequence = sequence;
+
+		size_t numRead = 0;
+		for (size_t i = 0; i < this->bindings.size(); ++i)
+		{
+			if (this->read(i))
+			{
+				++numRead;
+			}
+		}
+		return numRead;
+	}
+
+	//--------------------------------------------------------------
+	bool SharedBus::isWriter() const
+	{
+		return this->header && this->writer;
+	}
+
+	//--------------------------------------------------------------
+	bool SharedBus::isReader() const
+	{
+		return this->header && !this->writer;
+	}
+
+	//--------------------------------------------------------------
+	bool SharedBus::ReleaseStale(const string & name)
+	{
+		const auto fd = shm_open(name.c_str(), O_RDWR, 0);
+		if (fd < 0)
+		{
+			// Already gone.
+			return (errno == ENOENT);
+		}
+
+		struct stat info;
+		if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(Header))
+		{
+			auto memory = mmap(nullptr, sizeof(Header), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			if (memory != MAP_FAILED)
+			{
+				auto header = static_cast<Header *>(memory);
+				const auto pid = static_cast<pid_t>(header->writerPid);
+				if (pid > 0 && (kill(pid, 0) == 0 || errno == EPERM))
+				{
+					munmap(memory, sizeof(Header));
+					::close(fd);
+					return false;
+				}
+
+				// Readers still mapped to it attach again on their next update.
+				header->magic.store(0, std::memory_order_release);
+				munmap(memory, sizeof(Header));
+			}
+		}
+		::close(fd);
+
+		shm_unlink(name.c_str());
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	bool SharedBus::map(const string & name, bool writer)
+	{
+		// POSIX shared memory names must start with a slash.
+		this->name = (name.empty() || name[0] != '/') ? "/" + name : name;
+
+		auto size = sizeof(Header) + this->bindings.size() * sizeof(Slot);
+		if (writer)
+		{
+			// Never resize or rewrite a segment in place: readers mapped to it could fault past its new end,
+			// or accept a half-written header. They keep the old segment until they attach again.
+			this->fd = shm_open(this->name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+			if (this->fd < 0 && errno == EEXIST)
+			{
+				if (!ReleaseStale(this->name))
+				{
+					ofLogError(__FUNCTION__) << "Shared memory " << this->name << " is in use by another writer";
+					this->close();
+					return false;
+				}
+				this->fd = shm_open(this->name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+			}
+			if (this->fd < 0 || ftruncate(this->fd, size) != 0)
+			{
+				ofLogError(__FUNCTION__) << "Could not create shared memory " << this->name << ": " << strerror(errno);
+				this->close();
+				return false;
+			}
+		}
+		else
+		{
+			this->fd = shm_open(this->name.c_str(), O_RDONLY, 0);
+			struct stat info;
+			if (this->fd < 0 || fstat(this->fd, &info) != 0)
+			{
+				ofLogError(__FUNCTION__) << "Could not open shared memory " << this->name << ": " << strerror(errno);
+				this->close();
+				return false;
+			}
+			if (static_cast<size_t>(info.st_size) < sizeof(Header))
+			{
+				ofLogError(__FUNCTION__) << "Shared memory " << this->name << " is too small to be a parameter bus";
+				this->close();
+				return false;
+			}
+
+			// The layout is validated against the header in attach().
+			size = info.st_size;
+		}
+
+		this->memory = mmap(nullptr, size, writer ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, this->fd, 0);
+		if (this->memory == MAP_FAILED)
+		{
+			ofLogError(__FUNCTION__) << "Could not map shared memory " << this->name << ": " << strerror(errno);
+			this->memory = nullptr;
+			this->close();
+			return false;
+		}
+
+		this->memorySize = size;
+		this->writer = writer;
+		this->header = static_cast<Header *>(this->memory);
+		if (writer)
+		{
+			// Claim the segment right away, so other writers do not take it for a stale one.
+			this->header->writerPid = static_cast<int32_t>(getpid());
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	SharedBus::Slot & SharedBus::getSlot(size_t index) const
+	{
+		auto slots = reinterpret_cast<Slot *>(static_cast<char *>(this->memory) + sizeof(Header));
+		return slots[index];
+	}
+
+	//--------------------------------------------------------------
+	void SharedBus::write(size_t index)
+	{
+		const auto & binding = this->bindings[index];
+		auto & slot = this->getSlot(index);
+
+		if (!binding.isNumeric())
+		{
+			this->text = binding.parameter->toString();
+			if (this->text.size() >= kMaxStringLength)
+			{
+				ofLogWarning(__FUNCTION__) << "Value of " << binding.path << " is truncated to " << (kMaxStringLength - 1) << " characters";
+				this->text.resize(kMaxStringLength - 1);
+			}
+		}
+
+		// An odd sequence marks the slot as being written.
+		const auto sequence = slot.sequence.load(std::memory_order_relaxed);
+		slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		if (binding.isNumeric())
+		{
+			binding.getComponents(slot.values);
+		}
+		else
+		{
+			slot.length = static_cast<uint32_t>(this->text.size());
+			memcpy(slot.text, this->text.data(), this->text.size());
+		}
+
+		slot.sequence.store(sequence + 2, std::memory_order_release);
+		this->header->sequence.fetch_add(1, std::memory_order_release);
+	}
+
+	//--------------------------------------------------------------
+	bool SharedBus::read(size_t index)
+	{
+		const auto & binding = this->bindings[index];
+		const auto & slot = this->getSlot(index);
+
+		float values[Binding::kMaxComponents];
+		static const int kMaxAttempts = 64;
+		for (int attempt = 0; attempt < kMaxAttempts; ++attempt)
+		{
+			const auto before = slot.sequence.load(std::memory_order_acquire);
+			if (before == this->lastSlotSequences[index])
+			{
+				// Unchanged.
+				return false;
+			}
+			if (before & 1)
+			{
+				// Being written, try again.
+				continue;
+			}
+
+			if (binding.isNumeric())
+			{
+				memcpy(values, slot.values, sizeof(values));
+			}
+			else
+			{
+				const auto length = std::min<size_t>(slot.length, kMaxStringLength - 1);
+				this->text.assign(slot.text, length);
+			}
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.sequence.load(std::memory_order_relaxed) != before)
+			{
+				// Torn read, try again.
+				continue;
+			}
+
+			this->lastSlotSequences[index] = before;
+			if (binding.isNumeric())
+			{
+				binding.setComponents(values);
+			}
+			else
+			{
+				binding.parameter->fromString(this->text);
+			}
+			return true;
+		}
+
+		// The writer is too busy with this slot, pick it up on the next update.
+		this->lastSequence = std::numeric_limits<uint64_t>::max();
+		return false;
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Bank.h"
+#include "Store.h"
+
+namespace ofxPreset
+{
+	// Nearest neighbour search over the presets of a Bank.
+	// Values are normalized by the range of each parameter and kept in a padded contiguous array,
+	// so a brute force scan stays cheap enough to run every frame for thousands of presets.
+	class SimilarityIndex
+	{
+	public:
+		struct Result
+		{
+			size_t index;
+			float distance;
+		};
+
+		inline SimilarityIndex();
+
+		// Indexes every preset in the bank, using the current ranges of the store. Call again when the bank changes.
+		inline void setup(const Bank & bank, const Store & store);
+		inline void clear();
+
+		inline size_t size() const;
+		inline bool empty() const;
+
+		// Finds the k closest presets to the values, in the same layout as the store, sorted by distance.
+		inline void search(const float * values, size_t k, vector<Result> & results);
+		inline void search(const Store & store, size_t k, vector<Result> & results);
+
+		// Index of a preset within tolerance of the values, or -1 if there is none.
+		inline int findDuplicate(const float * values, float tolerance = 1e-4f);
+
+	protected:
+		inline void normalize(const float * values, float * out) const;
+		inline float getDistanceSquared(const float * a, const float * b) const;
+
+		size_t numComponents;
+		size_t stride;
+		size_t count;
+
+		vector<float> offsets;
+		vector<float> scales;
+		vector<float> points;
+		vector<float> query;
+	};
+}
+
+#include "SimilarityIndex.inl"
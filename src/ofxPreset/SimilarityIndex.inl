@@ -0,0 +1,172 @@
+#include "SimilarityIndex.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	SimilarityIndex::SimilarityIndex()
+		: numComponents(0)
+		, stride(0)
+		, count(0)
+	{}
+
+	//--------------------------------------------------------------
+	void SimilarityIndex::setup(const Bank & bank, const Store & store)
+	{
+		this->clear();
+
+		if (bank.getStride() != store.size())
+		{
+			ofLogWarning(__FUNCTION__) << "Bank does not match the store!";
+			return;
+		}
+
+		Store::Snapshot minValues;
+		Store::Snapshot maxValues;
+		store.getRange(minValues, maxValues);
+
+		// Pad to a multiple of 8 floats so the distance loop vectorizes without a remainder.
+		this->numComponents = store.size();
+		this->stride = (this->numComponents + 7) & ~static_cast<size_t>(7);
+		this->offsets.assign(this->stride, 0.0f);
+		this->scales.assign(this->stride, 0.0f);
+		for (size_t i = 0; i < this->numComponents; ++i)
+		{
+			// Unbounded components have no range to normalize with, leave them out.
+			const auto range = maxValues[i] - minValues[i];
+			if (std::isfinite(range) && range > 0.0f)
+			{
+				this->offsets[i] = minValues[i];
+				this->scales[i] = 1.0f / range;
+			}
+		}
+
+		this->count = bank.size();
+		this->points.assign(this->count * this->stride, 0.0f);
+		for (size_t i = 0; i < this->count; ++i)
+		{
+			this->normalize(bank.getValues(i), &this->points[i * this->stride]);
+		}
+		this->query.assign(this->stride, 0.0f);
+	}
+
+	//--------------------------------------------------------------
+	void SimilarityIndex::clear()
+	{
+		this->numComponents = 0;
+		this->stride = 0;
+		this->count = 0;
+		this->offsets.clear();
+		this->scales.clear();
+		this->points.clear();
+		this->query.clear();
+	}
+
+	//--------------------------------------------------------------
+	size_t SimilarityIndex::size() const
+	{
+		return this->count;
+	}
+
+	//--------------------------------------------------------------
+	bool SimilarityIndex::empty() const
+	{
+		return this->count == 0;
+	}
+
+	//--------------------------------------------------------------
+	void SimilarityIndex::search(const float * values, size_t k, vector<Result> & results)
+	{
+		results.clear();
+		k = std::min(k, this->count);
+		if (k == 0)
+		{
+			return;
+		}
+
+		this->normalize(values, this->query.data());
+
+		// Keep the k best in a sorted array, k is small so insertion beats a heap.
+		for (size_t i = 0; i < this->count; ++i)
+		{
+			const auto distance = this->getDistanceSquared(this->query.data(), &this->points[i * this->stride]);
+			if (results.size() == k)
+			{
+				if (distance >= results.back().distance)
+				{
+					continue;
+				}
+				results.pop_back();
+			}
+
+			auto it = results.end();
+			while (it != results.begin() && (it - 1)->distance > distance)
+			{
+				--it;
+			}
+			results.insert(it, Result{ i, distance });
+		}
+
+		for (auto & result : results)
+		{
+			result.distance = std::sqrt(result.distance);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void SimilarityIndex::search(const Store & store, size_t k, vector<Result> & results)
+	{
+		if (store.size() != this->numComponents)
+		{
+			ofLogWarning(__FUNCTION__) << "Store does not match the index!";
+			results.clear();
+			return;
+		}
+		this->search(store.data(), k, results);
+	}
+
+	//--------------------------------------------------------------
+	int SimilarityIndex::findDuplicate(const float * values, float tolerance)
+	{
+		if (this->count == 0)
+		{
+			return -1;
+		}
+
+		this->normalize(values, this->query.data());
+
+		const auto toleranceSquared = tolerance * tolerance;
+		for (size_t i = 0; i < this->count; ++i)
+		{
+			if (this->getDistanceSquared(this->query.data(), &this->points[i * this->stride]) <= toleranceSquared)
+			{
+				return static_cast<int>(i);
+			}
+		}
+		return -1;
+	}
+
+	//--------------------------------------------------------------
+	void SimilarityIndex::normalize(const float * values, float * out) const
+	{
+		for (size_t i = 0; i < this->numComponents; ++i)
+		{
+			out[i] = (values[i] - this->offsets[i]) * this->scales[i];
+		}
+	}
+
+	//--------------------------------------------------------------
+	float SimilarityIndex::getDistanceSquared(const float * a, const float * b) const
+	{
+		// Eight independent sums, which the compiler can keep in vector registers without reordering float adds.
+		float sums[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+		for (size_t i = 0; i < this->stride; i += 8)
+		{
+			for (size_t j = 0; j < 8; ++j)
+			{
+				const auto delta = a[i + j] - b[i + j];
+				sums[j] += delta * delta;
+			}
+		}
+		return ((sums[0] + sums[1]) + (sums[2] + sums[3])) + ((sums[4] + sums[5]) + (sums[6] + sums[7]));
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "ofEvents.h"
+#include "ofParameter.h"
+
+#include "Bindings.h"
+#include "Serializer.h"
+#include "Transaction.h"
+
+namespace ofxPreset
+{
+	// Glides numeric parameters (int, float, vector and color) to new values instead of jumping, e.g. on preset recall.
+	// Active transitions are advanced in one batch per update() and set through a single Transaction,
+	// settled ones drop out. Setting a gliding parameter from anywhere else cancels its transition.
+	class Slew
+	{
+	public:
+		enum class Easing : uint8_t
+		{
+			Linear,
+			In,
+			Out,
+			InOut
+		};
+
+		static inline float Ease(Easing easing, float amount);
+
+		inline Slew();
+
+		inline void setup(ofParameterGroup & group, float duration = 0.5f, Easing easing = Easing::InOut);
+		inline void clear();
+
+		// Settings apply to the parameter, or to every parameter inside a group. A duration of 0 jumps straight to the value.
+		inline void setDuration(const ofAbstractParameter & parameter, float duration);
+		// Speed in units per second of the component with the furthest to go, used instead of the duration if above 0.
+		inline void setRate(const ofAbstractParameter & parameter, float rate);
+		inline void setEasing(const ofAbstractParameter & parameter, Easing easing);
+
+		// Glides from the current value. Returns false if the parameter is not handled.
+		inline bool set(ofAbstractParameter & parameter, const float * values);
+
+		// Takes over the numeric values set by the transaction, putting them back where they were to glide from there.
+		// Must be called before the transaction is committed, other values are left to it.
+		inline size_t start(Transaction & transaction);
+
+		// Same as Serializer::Deserialize(), gliding to the loaded values.
+		inline void deserialize(const nlohmann::json & json);
+
+		// Jumps every transition to its target.
+		inline void finish();
+		// Leaves every parameter where it is.
+		inline void cancel();
+
+		inline size_t getNumActive() const;
+		inline bool isActive(const ofAbstractParameter & parameter) const;
+
+		inline void update();
+		inline void update(float deltaTime);
+
+	protected:
+		struct Setting
+		{
+			float duration;
+			float rate;
+			Easing easing;
+		};
+
+		struct Transition
+		{
+			size_t binding;
+			size_t offset;
+			size_t count;
+			float time;
+			float duration;
+			Easing easing;
+		};
+
+		inline void collect(const ofAbstractParameter & parameter, vector<size_t> & indices) const;
+		inline bool begin(size_t index, const float * targetValues);
+		inline void end(size_t transition);
+
+		Bindings bindings;
+		ofEventListener listener;
+
+		vector<Setting> settings;
+		vector<int> offsetByBinding;
+		vector<int> transitionByBinding;
+
+		// Active transitions only, advanced in order by update().
+		vector<Transition> transitions;
+
+		// One float per component of every numeric parameter, in binding order.
+		vector<float> values;
+		vector<float> startValues;
+		vector<float> targetValues;
+
+		bool updating;
+	};
+}
+
+#include "Slew.inl"
@@ -0,0 +1,388 @@
+#include "Slew.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	float Slew::Ease(Easing easing, float amount)
+	{
+		switch (easing)
+		{
+		case Easing::In:
+			return amount * amount * amount;
+		case Easing::Out:
+		{
+			const auto inverse = 1.0f - amount;
+			return 1.0f - inverse * inverse * inverse;
+		}
+		case Easing::InOut:
+		{
+			if (amount < 0.5f)
+			{
+				return 4.0f * amount * amount * amount;
+			}
+			const auto inverse = 2.0f - 2.0f * amount;
+			return 1.0f - inverse * inverse * inverse * 0.5f;
+		}
+		default:
+			return amount;
+		}
+	}
+
+	//--------------------------------------------------------------
+	Slew::Slew()
+		: updating(false)
+	{}
+
+	//--------------------------------------------------------------
+	void Slew::setup(ofParameterGroup & group, float duration, Easing easing)
+	{
+		this->clear();
+
+		this->bindings.setup(group);
+
+		Setting setting;
+		setting.duration = duration;
+		setting.rate = 0.0f;
+		setting.easing = easing;
+		this->settings.assign(this->bindings.size(), setting);
+
+		this->offsetByBinding.assign(this->bindings.size(), -1);
+		this->transitionByBinding.assign(this->bindings.size(), -1);
+		for (size_t i = 0; i < this->bindings.size(); ++i)
+		{
+			const auto & binding = this->bindings[i];
+			if (!binding.isNumeric())
+			{
+				continue;
+			}
+
+			this->offsetByBinding[i] = static_cast<int>(this->values.size());
+			this->values.resize(this->values.size() + binding.getNumComponents());
+			binding.getComponents(&this->values[this->offsetByBinding[i]]);
+		}
+		this->startValues.resize(this->values.size());
+		this->targetValues.resize(this->values.size());
+
+		this->listener = this->bindings.getGroup().parameterChangedE().newListener([this](ofAbstractParameter & parameter)
+		{
+			const auto index = this->bindings.indexOf(parameter);
+			if (index < 0 || this->offsetByBinding[index] < 0)
+			{
+				return;
+			}
+
+			const auto offset = this->offsetByBinding[index];
+			float current[Binding::kMaxComponents];
+			const auto count = this->bindings[index].getComponents(current);
+
+			// Set from somewhere else, let it go.
+			const auto transition = this->transitionByBinding[index];
+			if (transition >= 0 && !this->updating)
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					if (current[i] != this->values[offset + i])
+					{
+						this->end(transition);
+						break;
+					}
+				}
+			}
+
+			std::copy(current, current + count, this->values.begin() + offset);
+		});
+	}
+
+	//--------------------------------------------------------------
+	void Slew::clear()
+	{
+		this->listener.unsubscribe();
+		this->bindings.clear();
+		this->settings.clear();
+		this->offsetByBinding.clear();
+		this->transitionByBinding.clear();
+		this->transitions.clear();
+		this->values.clear();
+		this->startValues.clear();
+		this->targetValues.clear();
+	}
+
+	//--------------------------------------------------------------
+	void Slew::setDuration(const ofAbstractParameter & parameter, float duration)
+	{
+		vector<size_t> indices;
+		this->collect(parameter, indices);
+		for (auto index : indices)
+		{
+			this->settings[index].duration = duration;
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Slew::setRate(const ofAbstractParameter & parameter, float rate)
+	{
+		vector<size_t> indices;
+		this->collect(parameter, indices);
+		for (auto index : indices)
+		{
+			this->settings[index].rate = rate;
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Slew::setEasing(const ofAbstractParameter & parameter, Easing easing)
+	{
+		vector<size_t> indices;
+		this->collect(parameter, indices);
+		for (auto index : indices)
+		{
+			this->settings[index].easing = easing;
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool Slew::set(ofAbstractParameter & parameter, const float * values)
+	{
+		const auto index = this->bindings.indexOf(parameter);
+		if (index < 0 || this->offsetByBinding[index] < 0)
+		{
+			ofLogWarning(__FUNCTION__) << "Parameter " << parameter.getName() << " is not handled!";
+			return false;
+		}
+
+		if (!this->begin(index, values))
+		{
+			// No transition, jump straight there.
+			const auto transition = this->transitionByBinding[index];
+			if (transition >= 0)
+			{
+				this->end(transition);
+			}
+			this->bindings[index].setComponents(values);
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	size_t Slew::start(Transaction & transaction)
+	{
+		if (transaction.isCommitted())
+		{
+			ofLogWarning(__FUNCTION__) << "Transaction already committed!";
+			return 0;
+		}
+
+		size_t count = 0;
+		float values[Binding::kMaxComponents];
+		for (size_t i = 0; i < this->bindings.size(); ++i)
+		{
+			const auto & binding = this->bindings[i];
+			if (this->offsetByBinding[i] < 0 || !transaction.isChanged(*binding.parameter))
+			{
+				continue;
+			}
+
+			// The transaction set the value silently, the last notified value is still stored.
+			binding.getComponents(values);
+			if (this->begin(i, values))
+			{
+				// Put the stored value back and take it out of the transaction, the slew notifies as it moves.
+				binding.setComponents(&this->values[this->offsetByBinding[i]], false);
+				transaction.revert(*binding.parameter);
+				++count;
+			}
+			else
+			{
+				const auto transition = this->transitionByBinding[i];
+				if (transition >= 0)
+				{
+					this->end(transition);
+				}
+			}
+		}
+		return count;
+	}
+
+	//--------------------------------------------------------------
+	void Slew::deserialize(const nlohmann::json & json)
+	{
+		auto & group = this->bindings.getGroup();
+		Transaction transaction(group);
+		Serializer::Deserialize(json, group, transaction);
+		this->start(transaction);
+		transaction.commit();
+	}
+
+	//--------------------------------------------------------------
+	void Slew::finish()
+	{
+		if (this->transitions.empty())
+		{
+			return;
+		}
+
+		Transaction transaction(this->bindings.getGroup());
+		for (const auto & transition : this->transitions)
+		{
+			const auto & binding = this->bindings[transition.binding];
+			transaction.set(*binding.parameter, binding.type, &this->targetValues[transition.offset]);
+			this->transitionByBinding[transition.binding] = -1;
+		}
+		this->transitions.clear();
+
+		this->updating = true;
+		transaction.commit();
+		this->updating = false;
+	}
+
+	//--------------------------------------------------------------
+	void Slew::cancel()
+	{
+		for (const auto & transition : this->transitions)
+		{
+			this->transitionByBinding[transition.binding] = -1;
+		}
+		this->transitions.clear();
+	}
+
+	//--------------------------------------------------------------
+	size_t Slew::getNumActive() const
+	{
+		return this->transitions.size();
+	}
+
+	//--------------------------------------------------------------
+	bool Slew::isActive(const ofAbstractParameter & parameter) const
+	{
+		const auto index = this->bindings.indexOf(parameter);
+		return index >= 0 && this->transitionByBinding[index] >= 0;
+	}
+
+	//--------------------------------------------------------------
+	void Slew::update()
+	{
+		this->update(ofGetLastFrameTime());
+	}
+
+	//--------------------------------------------------------------
+	void Slew::update(float deltaTime)
+	{
+		if (this->transitions.empty())
+		{
+			return;
+		}
+
+		// Set everything first, so listeners see a consistent state.
+		Transaction transaction(this->bindings.getGroup());
+		float values[Binding::kMaxComponents];
+		size_t i = 0;
+		while (i < this->transitions.size())
+		{
+			auto & transition = this->transitions[i];
+			transition.time += deltaTime;
+
+			const auto settled = transition.time >= transition.duration;
+			const auto amount = settled ? 1.0f : Ease(transition.easing, transition.time / transition.duration);
+			const auto startValues = &this->startValues[transition.offset];
+			const auto targetValues = &this->targetValues[transition.offset];
+			for (size_t c = 0; c < transition.count; ++c)
+			{
+				values[c] = settled ? targetValues[c] : startValues[c] + (targetValues[c] - startValues[c]) * amount;
+			}
+
+			const auto & binding = this->bindings[transition.binding];
+			transaction.set(*binding.parameter, binding.type, values);
+
+			if (settled)
+			{
+				// Swaps the last transition in, check the same slot again.
+				this->end(i);
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		this->updating = true;
+		transaction.commit();
+		this->updating = false;
+	}
+
+	//--------------------------------------------------------------
+	void Slew::collect(const ofAbstractParameter & parameter, vector<size_t> & indices) const
+	{
+		// Group.
+		const auto parameterGroup = dynamic_cast<const ofParameterGroup *>(&parameter);
+		if (parameterGroup)
+		{
+			// Recurse through contents.
+			for (const auto & child : *parameterGroup)
+			{
+				if (child)
+				{
+					this->collect(*child, indices);
+				}
+			}
+			return;
+		}
+
+		// Parameter.
+		const auto index = this->bindings.indexOf(parameter);
+		if (index >= 0)
+		{
+			indices.push_back(index);
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool Slew::begin(size_t index, const float * targetValues)
+	{
+		const auto & setting = this->settings[index];
+		const auto offset = this->offsetByBinding[index];
+		const auto count = this->bindings[index].getNumComponents();
+
+		auto distance = 0.0f;
+		for (size_t i = 0; i < count; ++i)
+		{
+			distance = std::max(distance, fabsf(targetValues[i] - this->values[offset + i]));
+		}
+		const auto duration = (setting.rate > 0.0f) ? distance / setting.rate : setting.duration;
+		if (duration <= 0.0f || distance == 0.0f)
+		{
+			return false;
+		}
+
+		// Start from wherever the parameter is now, even halfway through another transition.
+		std::copy(this->values.begin() + offset, this->values.begin() + offset + count, this->startValues.begin() + offset);
+		std::copy(targetValues, targetValues + count, this->targetValues.begin() + offset);
+
+		auto transition = this->transitionByBinding[index];
+		if (transition < 0)
+		{
+			transition = static_cast<int>(this->transitions.size());
+			this->transitions.emplace_back();
+			this->transitionByBinding[index] = transition;
+		}
+		auto & active = this->transitions[transition];
+		active.binding = index;
+		active.offset = offset;
+		active.count = count;
+		active.time = 0.0f;
+		active.duration = duration;
+		active.easing = setting.easing;
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	void Slew::end(size_t transition)
+	{
+		this->transitionByBinding[this->transitions[transition].binding] = -1;
+		if (transition + 1 < this->transitions.size())
+		{
+			this->transitions[transition] = this->transitions.back();
+			this->transitionByBinding[this->transitions[transition].binding] = static_cast<int>(transition);
+		}
+		this->transitions.pop_back();
+	}
+}
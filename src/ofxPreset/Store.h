@@ -0,0 +1,66 @@
+#pragma once
+
+#include "ofParameter.h"
+
+#include "Bindings.h"
+#include "Modulation.h"
+#include "Transaction.h"
+
+namespace ofxPreset
+{
+	// Contiguous copy of the numeric values of a group, one float per component, kept up to date as parameters change.
+	// Whole-group snapshots, blends and hashes then work on a flat array instead of chasing every parameter.
+	class Store
+	{
+	public:
+		typedef vector<float> Snapshot;
+
+		// Linear interpolation of every component, out can be either input.
+		static inline void Blend(const Snapshot & from, const Snapshot & to, float amount, Snapshot & out);
+
+		inline Store();
+
+		inline void setup(ofParameterGroup & group);
+		inline void clear();
+
+		// Number of components of all numeric parameters.
+		inline size_t size() const;
+		inline bool empty() const;
+
+		// Current values, in binding order.
+		inline const float * data() const;
+
+		// Offset of the parameter's components in data(), or -1 if it is not stored.
+		inline int getOffset(const ofAbstractParameter & parameter) const;
+
+		// Current min and max of every component, read from the parameters.
+		inline void getRange(Snapshot & minValues, Snapshot & maxValues) const;
+
+		// Whether each component holds a bool or an int, whose values must round trip exactly.
+		inline void getIntegers(vector<uint8_t> & integers) const;
+
+		inline void capture(Snapshot & snapshot) const;
+
+		// Sets every changed parameter to the snapshot value, and notifies them once all values are in place.
+		inline void apply(const Snapshot & snapshot);
+		inline void apply(const Snapshot & snapshot, Transaction & transaction);
+
+		inline void blend(const Snapshot & from, const Snapshot & to, float amount);
+
+		inline uint64_t getHash() const;
+		inline uint64_t getSchemaHash() const;
+
+	protected:
+		inline void update(size_t index);
+
+		Bindings bindings;
+		ofEventListener listener;
+
+		vector<int> offsetByBinding;
+		vector<size_t> storedBindings;
+		vector<float> values;
+		Snapshot scratch;
+	};
+}
+
+#include "Store.inl"
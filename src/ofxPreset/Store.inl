@@ -0,0 +1,192 @@
+#include "Store.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	void Store::Blend(const Snapshot & from, const Snapshot & to, float amount, Snapshot & out)
+	{
+		if (from.size() != to.size())
+		{
+			ofLogWarning(__FUNCTION__) << "Snapshots have different sizes!";
+			return;
+		}
+
+		out.resize(from.size());
+		const auto count = from.size();
+		const auto fromValues = from.data();
+		const auto toValues = to.data();
+		const auto outValues = out.data();
+		for (size_t i = 0; i < count; ++i)
+		{
+			outValues[i] = fromValues[i] + (toValues[i] - fromValues[i]) * amount;
+		}
+	}
+
+	//--------------------------------------------------------------
+	Store::Store()
+	{}
+
+	//--------------------------------------------------------------
+	void Store::setup(ofParameterGroup & group)
+	{
+		this->clear();
+
+		this->bindings.setup(group);
+		this->offsetByBinding.assign(this->bindings.size(), -1);
+		for (size_t i = 0; i < this->bindings.size(); ++i)
+		{
+			const auto & binding = this->bindings[i];
+			if (!binding.isNumeric())
+			{
+				continue;
+			}
+
+			this->offsetByBinding[i] = static_cast<int>(this->values.size());
+			this->storedBindings.push_back(i);
+			this->values.resize(this->values.size() + binding.getNumComponents());
+			binding.getComponents(&this->values[this->offsetByBinding[i]]);
+		}
+
+		this->listener = this->bindings.getGroup().parameterChangedE().newListener([this](ofAbstractParameter & parameter)
+		{
+			const auto index = this->bindings.indexOf(parameter);
+			if (index >= 0 && this->offsetByBinding[index] >= 0)
+			{
+				this->update(index);
+			}
+		});
+	}
+
+	//--------------------------------------------------------------
+	void Store::clear()
+	{
+		this->listener.unsubscribe();
+		this->bindings.clear();
+		this->offsetByBinding.clear();
+		this->storedBindings.clear();
+		this->values.clear();
+	}
+
+	//--------------------------------------------------------------
+	size_t Store::size() const
+	{
+		return this->values.size();
+	}
+
+	//--------------------------------------------------------------
+	bool Store::empty() const
+	{
+		return this->values.empty();
+	}
+
+	//--------------------------------------------------------------
+	const float * Store::data() const
+	{
+		return this->values.data();
+	}
+
+	//--------------------------------------------------------------
+	int Store::getOffset(const ofAbstractParameter & parameter) const
+	{
+		const auto index = this->bindings.indexOf(parameter);
+		return (index < 0) ? -1 : this->offsetByBinding[index];
+	}
+
+	//--------------------------------------------------------------
+	void Store::getRange(Snapshot & minValues, Snapshot & maxValues) const
+	{
+		minValues.resize(this->values.size());
+		maxValues.resize(this->values.size());
+		for (auto index : this->storedBindings)
+		{
+			const auto offset = this->offsetByBinding[index];
+			this->bindings[index].getRange(&minValues[offset], &maxValues[offset]);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Store::getIntegers(vector<uint8_t> & integers) const
+	{
+		integers.assign(this->values.size(), 0);
+		for (auto index : this->storedBindings)
+		{
+			const auto type = this->bindings[index].type;
+			integers[this->offsetByBinding[index]] = (type == Binding::Type::Bool || type == Binding::Type::Int);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Store::capture(Snapshot & snapshot) const
+	{
+		snapshot = this->values;
+
+		// Capture the base value of modulated parameters, not whatever the modulator is at right now.
+		for (auto index : this->storedBindings)
+		{
+			Modulation::GetBase(this->bindings[index], &snapshot[this->offsetByBinding[index]]);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Store::apply(const Snapshot & snapshot)
+	{
+		Transaction transaction(this->bindings.getGroup());
+		this->apply(snapshot, transaction);
+		transaction.commit();
+	}
+
+	//--------------------------------------------------------------
+	void Store::apply(const Snapshot & snapshot, Transaction & transaction)
+	{
+		if (snapshot.size() != this->values.size())
+		{
+			ofLogWarning(__FUNCTION__) << "Snapshot does not match the store!";
+			return;
+		}
+
+		for (auto index : this->storedBindings)
+		{
+			const auto & binding = this->bindings[index];
+			const auto offset = this->offsetByBinding[index];
+			const auto count = binding.getNumComponents();
+
+			// Only touch the parameters that differ from their live value, which silent writes may have
+			// changed without the store hearing about it.
+			this->update(index);
+			if (memcmp(&this->values[offset], &snapshot[offset], count * sizeof(float)) == 0)
+			{
+				continue;
+			}
+			if (transaction.set(*binding.parameter, binding.type, &snapshot[offset]))
+			{
+				// Changes are notified on commit, read back now as ints get rounded.
+				this->update(index);
+			}
+		}
+	}
+
+	//--------------------------------------------------------------
+	void Store::blend(const Snapshot & from, const Snapshot & to, float amount)
+	{
+		Blend(from, to, amount, this->scratch);
+		this->apply(this->scratch);
+	}
+
+	//--------------------------------------------------------------
+	uint64_t Store::getHash() const
+	{
+		return Bindings::Hash(this->values.data(), this->values.size() * sizeof(float));
+	}
+
+	//--------------------------------------------------------------
+	uint64_t Store::getSchemaHash() const
+	{
+		return this->bindings.getSchemaHash();
+	}
+
+	//--------------------------------------------------------------
+	void Store::update(size_t index)
+	{
+		this->bindings[index].getComponents(&this->values[this->offsetByBinding[index]]);
+	}
+}
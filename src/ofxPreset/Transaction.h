@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ofEvents.h"
+#include "ofParameter.h"
+
+#include "Bindings.h"
+
+namespace ofxPreset
+{
+	// Applies many parameter values without notifying anyone, then fires all the
+	// change events in one go on commit(), once every value is in place.
+	class Transaction
+	{
+	public:
+		struct Changes
+		{
+			ofParameterGroup group;
+			vector<shared_ptr<ofAbstractParameter>> parameters;
+		};
+
+		// Fired once per committed transaction for each group with changed descendants.
+		// The event lives as long as someone holds on to it, keep the returned pointer along with its listeners.
+		static inline shared_ptr<ofEvent<const Changes>> GetCommitEvent(ofParameterGroup & group);
+
+		inline Transaction(ofParameterGroup & group, bool notifyParameters = true);
+		inline ~Transaction();
+
+		// Returns false if the parameter already had this value, in which case it is not recorded.
+		inline bool set(ofAbstractParameter & parameter, const string & valueString);
+		template<typename ParameterType>
+		inline bool set(ofParameter<ParameterType> & parameter, const ParameterType & value);
+		inline bool set(ofAbstractParameter & parameter, Binding::Type type, const float * values);
+
+		// Drops the parameter from the changes, so it is neither notified nor reported on commit.
+		// Its value is left as is, put back the one it had if listeners should not miss anything.
+		// Returns false if the transaction did not change it.
+		inline bool revert(const ofAbstractParameter & parameter);
+
+		// Fires the change events of every parameter set so far, then the commit events.
+		inline void commit();
+
+		inline bool empty() const;
+		inline size_t size() const;
+		inline bool isCommitted() const;
+
+		// Whether the transaction changed the value of this parameter, to skip dependent work.
+		inline bool isChanged(const ofAbstractParameter & parameter) const;
+
+	protected:
+		struct CommitEvent
+		{
+			// Keeps the group alive, so no other group can take its address while the event is around.
+			ofParameterGroup group;
+			weak_ptr<ofEvent<const Changes>> event;
+		};
+
+		// Keyed by the group's event, which is shared by all references to the same group.
+		static inline unordered_map<const void *, CommitEvent> & GetCommitEvents();
+
+		struct Change
+		{
+			// Null once reverted.
+			ofAbstractParameter * parameter;
+			Binding::Type type;
+			const void * identity;
+		};
+
+		inline void record(ofAbstractParameter & parameter, Binding::Type type);
+		inline void collect(ofParameterGroup & group, vector<shared_ptr<ofAbstractParameter>> & parameters);
+
+		ofParameterGroup group;
+		bool notifyParameters;
+		bool committed;
+
+		vector<Change> changes;
+		unordered_map<const void *, size_t> indexByIdentity;
+		size_t numReverted;
+	};
+}
+
+#include "Transaction.inl"
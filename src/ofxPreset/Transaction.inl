@@ -0,0 +1,278 @@
+#include "Transaction.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	shared_ptr<ofEvent<const Transaction::Changes>> Transaction::GetCommitEvent(ofParameterGroup & group)
+	{
+		const auto key = static_cast<const void *>(&group.parameterChangedE());
+		auto & commitEvent = GetCommitEvents()[key];
+		auto event = commitEvent.event.lock();
+		if (!event)
+		{
+			// The entry goes away with the last holder of the event, along with the group it keeps alive.
+			event = shared_ptr<ofEvent<const Changes>>(new ofEvent<const Changes>(), [key](ofEvent<const Changes> * event)
+			{
+				auto & events = GetCommitEvents();
+				const auto it = events.find(key);
+				if (it != events.end() && it->second.event.expired())
+				{
+					events.erase(it);
+				}
+				delete event;
+			});
+			commitEvent.group = group;
+			commitEvent.event = event;
+		}
+		return event;
+	}
+
+	//--------------------------------------------------------------
+	unordered_map<const void *, Transaction::CommitEvent> & Transaction::GetCommitEvents()
+	{
+		// Never destroyed, events may be released during static destruction.
+		static auto events = new unordered_map<const void *, CommitEvent>();
+		return *events;
+	}
+
+	//--------------------------------------------------------------
+	Transaction::Transaction(ofParameterGroup & group, bool notifyParameters)
+		: group(group)
+		, notifyParameters(notifyParameters)
+		, committed(false)
+		, numReverted(0)
+	{}
+
+	//--------------------------------------------------------------
+	Transaction::~Transaction()
+	{
+		if (!this->committed)
+		{
+			this->commit();
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool Transaction::set(ofAbstractParameter & parameter, const string & valueString)
+	{
+		const auto type = Binding::GetType(parameter);
+		if (!Binding::FromString(parameter, type, valueString, false))
+		{
+			return false;
+		}
+		this->record(parameter, type);
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	template<typename ParameterType>
+	bool Transaction::set(ofParameter<ParameterType> & parameter, const ParameterType & value)
+	{
+		if (parameter.get() == value)
+		{
+			return false;
+		}
+		parameter.setWithoutEventNotifications(value);
+		this->record(parameter, Binding::GetType(parameter));
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	bool Transaction::set(ofAbstractParameter & parameter, Binding::Type type, const float * values)
+	{
+		if (!Binding::SetComponents(parameter, type, values, false))
+		{
+			return false;
+		}
+		this->record(parameter, type);
+		return true;
+	}
+
+	//--------------------------------------------------------------
+	bool Transaction::revert(const ofAbstractParameter & parameter)
+	{
+		if (this->committed)
+		{
+			ofLogWarning(__FUNCTION__) << "Transaction on group " << this->group.getName() << " already committed!";
+			return false;
+		}
+
+		const auto identity = Binding::GetIdentity(parameter, Binding::GetType(parameter));
+		if (identity)
+		{
+			const auto it = this->indexByIdentity.find(identity);
+			if (it == this->indexByIdentity.end())
+			{
+				return false;
+			}
+
+			// Leave a hole rather than shifting the rest, the indices of later changes stay valid.
+			this->changes[it->second].parameter = nullptr;
+			this->indexByIdentity.erase(it);
+			++this->numReverted;
+			return true;
+		}
+
+		// Unknown types have no identity, fall back to a linear search.
+		for (auto & change : this->changes)
+		{
+			if (change.parameter && !change.identity && change.parameter->isReferenceTo(parameter))
+			{
+				change.parameter = nullptr;
+				++this->numReverted;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	//--------------------------------------------------------------
+	void Transaction::commit()
+	{
+		if (this->committed)
+		{
+			ofLogWarning(__FUNCTION__) << "Transaction on group " << this->group.getName() << " already committed!";
+			return;
+		}
+		this->committed = true;
+
+		if (this->empty())
+		{
+			return;
+		}
+
+		// Every value is in place, let the parameters' own listeners know.
+		if (this->notifyParameters)
+		{
+			for (const auto & change : this->changes)
+			{
+				if (change.parameter && change.type != Binding::Type::Unknown)
+				{
+					Binding::Notify(*change.parameter, change.type);
+				}
+			}
+		}
+
+		// One notification per group.
+		if (!GetCommitEvents().empty())
+		{
+			vector<shared_ptr<ofAbstractParameter>> parameters;
+			this->collect(this->group, parameters);
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool Transaction::empty() const
+	{
+		return this->size() == 0;
+	}
+
+	//--------------------------------------------------------------
+	size_t Transaction::size() const
+	{
+		return this->changes.size() - this->numReverted;
+	}
+
+	//--------------------------------------------------------------
+	bool Transaction::isCommitted() const
+	{
+		return this->committed;
+	}
+
+	//--------------------------------------------------------------
+	void Transaction::record(ofAbstractParameter & parameter, Binding::Type type)
+	{
+		if (this->committed)
+		{
+			ofLogWarning(__FUNCTION__) << "Transaction on group " << this->group.getName() << " already committed, " << parameter.getName() << " will not be notified";
+			return;
+		}
+
+		const auto identity = Binding::GetIdentity(parameter, type);
+		if (identity)
+		{
+			if (!this->indexByIdentity.emplace(identity, this->changes.size()).second)
+			{
+				// Already recorded.
+				return;
+			}
+		}
+		else if (this->isChanged(parameter))
+		{
+			return;
+		}
+
+		Change change;
+		change.parameter = &parameter;
+		change.type = type;
+		change.identity = identity;
+		this->changes.push_back(change);
+	}
+
+	//--------------------------------------------------------------
+	bool Transaction::isChanged(const ofAbstractParameter & parameter) const
+	{
+		const auto identity = Binding::GetIdentity(parameter, Binding::GetType(parameter));
+		if (identity)
+		{
+			return this->indexByIdentity.count(identity) > 0;
+		}
+
+		// Unknown types have no identity, fall back to a linear search.
+		for (const auto & change : this->changes)
+		{
+			if (change.parameter && !change.identity && change.parameter->isReferenceTo(parameter))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	//--------------------------------------------------------------
+	void Transaction::collect(ofParameterGroup & group, vector<shared_ptr<ofAbstractParameter>> & parameters)
+	{
+		const auto numParameters = parameters.size();
+		for (const auto & parameter : group)
+		{
+			if (!parameter)
+			{
+				continue;
+			}
+
+			// Group.
+			auto parameterGroup = dynamic_pointer_cast<ofParameterGroup>(parameter);
+			if (parameterGroup)
+			{
+				// Recurse through contents.
+				this->collect(*parameterGroup, parameters);
+				continue;
+			}
+
+			// Parameter.
+			if (this->isChanged(*parameter))
+			{
+				parameters.push_back(parameter);
+			}
+		}
+
+		if (parameters.size() > numParameters)
+		{
+			// Only groups whose event someone holds on to are notified.
+			const auto & events = GetCommitEvents();
+			const auto it = events.find(&group.parameterChangedE());
+			if (it != events.end())
+			{
+				// Keep the event alive, its listeners may go away while it fires.
+				const auto event = it->second.event.lock();
+				if (event)
+				{
+					Changes groupChanges;
+					groupChanges.group = group;
+					groupChanges.parameters.assign(parameters.begin() + numParameters, parameters.end());
+					event->notify(groupChanges);
+				}
+			}
+		}
+	}
+}
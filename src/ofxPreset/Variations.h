@@ -0,0 +1,74 @@
+#pragma once
+
+#include "ofParameter.h"
+
+#include "Bank.h"
+#include "Store.h"
+
+namespace ofxPreset
+{
+	// Generates batches of variants of the current values of a Store, within each parameter's range.
+	// Variants are kept back to back in a single array and applied through the store, so previewing one
+	// only touches the parameters that differ. The same seed always generates the same variants.
+	class Variations
+	{
+	public:
+		inline Variations();
+
+		// The store must outlive the variations.
+		inline void setup(Store & store);
+		inline void clear();
+
+		inline void setSeed(uint64_t seed);
+		inline uint64_t getSeed() const;
+
+		// Locked parameters keep their current value in every variant.
+		inline void setLocked(const ofAbstractParameter & parameter, bool locked);
+		inline bool isLocked(const ofAbstractParameter & parameter) const;
+
+		// Scales how far the parameter can move, 1 by default.
+		inline void setStrength(const ofAbstractParameter & parameter, float strength);
+		inline float getStrength(const ofAbstractParameter & parameter) const;
+
+		// Moves every value by up to strength times its range, in either direction.
+		inline void mutate(size_t count, float strength);
+
+		// Picks every value anywhere in its range.
+		inline void randomize(size_t count);
+
+		inline size_t size() const;
+		inline bool empty() const;
+
+		// Values of a variant, in the same layout as the store.
+		inline const float * getValues(size_t index) const;
+
+		// Applies a variant to the parameters, restore() goes back to the values it was generated from.
+		inline void preview(size_t index);
+		inline void restore();
+
+		inline int save(size_t index, Bank & bank, const string & name) const;
+
+	protected:
+		static inline uint64_t NextRandom(uint64_t & state);
+		static inline float NextFloat(uint64_t & state);
+
+		inline void generate(size_t count, float strength, bool random);
+		inline bool getComponents(const ofAbstractParameter & parameter, int & offset, size_t & count) const;
+
+		Store * store;
+		uint64_t seed;
+
+		vector<uint8_t> locks;
+		vector<float> strengths;
+
+		Store::Snapshot base;
+		Store::Snapshot minValues;
+		Store::Snapshot maxValues;
+		Store::Snapshot scratch;
+
+		vector<float> values;
+		size_t count;
+	};
+}
+
+#include "Variations.inl"
@@ -0,0 +1,220 @@
+#include "Variations.h"
+
+namespace ofxPreset
+{
+	//--------------------------------------------------------------
+	uint64_t Variations::NextRandom(uint64_t & state)
+	{
+		// SplitMix64, the same sequence on every platform unlike the std distributions.
+		auto z = (state += 0x9e3779b97f4a7c15ULL);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+
+	//--------------------------------------------------------------
+	float Variations::NextFloat(uint64_t & state)
+	{
+		// 24 random bits in [0, 1).
+		return (NextRandom(state) >> 40) * (1.0f / 16777216.0f);
+	}
+
+	//--------------------------------------------------------------
+	Variations::Variations()
+		: store(nullptr)
+		, seed(0)
+		, count(0)
+	{}
+
+	//--------------------------------------------------------------
+	void Variations::setup(Store & store)
+	{
+		this->clear();
+
+		this->store = &store;
+		this->locks.assign(store.size(), 0);
+		this->strengths.assign(store.size(), 1.0f);
+	}
+
+	//--------------------------------------------------------------
+	void Variations::clear()
+	{
+		this->values.clear();
+		this->count = 0;
+	}
+
+	//--------------------------------------------------------------
+	void Variations::setSeed(uint64_t seed)
+	{
+		this->seed = seed;
+	}
+
+	//--------------------------------------------------------------
+	uint64_t Variations::getSeed() const
+	{
+		return this->seed;
+	}
+
+	//--------------------------------------------------------------
+	void Variations::setLocked(const ofAbstractParameter & parameter, bool locked)
+	{
+		int offset;
+		size_t count;
+		if (this->getComponents(parameter, offset, count))
+		{
+			std::fill(this->locks.begin() + offset, this->locks.begin() + offset + count, locked ? 1 : 0);
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool Variations::isLocked(const ofAbstractParameter & parameter) const
+	{
+		int offset;
+		size_t count;
+		return this->getComponents(parameter, offset, count) && this->locks[offset];
+	}
+
+	//--------------------------------------------------------------
+	void Variations::setStrength(const ofAbstractParameter & parameter, float strength)
+	{
+		int offset;
+		size_t count;
+		if (this->getComponents(parameter, offset, count))
+		{
+			std::fill(this->strengths.begin() + offset, this->strengths.begin() + offset + count, strength);
+		}
+	}
+
+	//--------------------------------------------------------------
+	float Variations::getStrength(const ofAbstractParameter & parameter) const
+	{
+		int offset;
+		size_t count;
+		return this->getComponents(parameter, offset, count) ? this->strengths[offset] : 0.0f;
+	}
+
+	//--------------------------------------------------------------
+	void Variations::mutate(size_t count, float strength)
+	{
+		this->generate(count, strength, false);
+	}
+
+	//--------------------------------------------------------------
+	void Variations::randomize(size_t count)
+	{
+		this->generate(count, 1.0f, true);
+	}
+
+	//--------------------------------------------------------------
+	size_t Variations::size() const
+	{
+		return this->count;
+	}
+
+	//--------------------------------------------------------------
+	bool Variations::empty() const
+	{
+		return this->count == 0;
+	}
+
+	//--------------------------------------------------------------
+	const float * Variations::getValues(size_t index) const
+	{
+		return this->values.data() + index * this->base.size();
+	}
+
+	//--------------------------------------------------------------
+	void Variations::preview(size_t index)
+	{
+		if (index >= this->count)
+		{
+			ofLogWarning(__FUNCTION__) << "Index " << index << " out of range!";
+			return;
+		}
+
+		const auto values = this->getValues(index);
+		this->scratch.assign(values, values + this->base.size());
+		this->store->apply(this->scratch);
+	}
+
+	//--------------------------------------------------------------
+	void Variations::restore()
+	{
+		if (this->store && !this->base.empty())
+		{
+			this->store->apply(this->base);
+		}
+	}
+
+	//--------------------------------------------------------------
+	int Variations::save(size_t index, Bank & bank, const string & name) const
+	{
+		if (index >= this->count || bank.getStride() != this->base.size())
+		{
+			ofLogWarning(__FUNCTION__) << "Variation " << index << " does not fit in the bank!";
+			return -1;
+		}
+		return bank.add(name, this->getValues(index));
+	}
+
+	//--------------------------------------------------------------
+	void Variations::generate(size_t count, float strength, bool random)
+	{
+		if (!this->store)
+		{
+			ofLogWarning(__FUNCTION__) << "Variations are not set up!";
+			return;
+		}
+		if (this->locks.size() != this->store->size())
+		{
+			ofLogWarning(__FUNCTION__) << "Store was set up again, call setup() first!";
+			return;
+		}
+
+		// Ranges can change at runtime, read them every time.
+		this->store->capture(this->base);
+		this->store->getRange(this->minValues, this->maxValues);
+
+		const auto stride = this->base.size();
+		this->values.resize(count * stride);
+		this->count = count;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			// Each variant has its own sequence, so it does not depend on how many were generated.
+			uint64_t state = this->seed ^ ((i + 1) * 0xd1b54a32d192ed03ULL);
+			auto variant = this->values.data() + i * stride;
+			for (size_t j = 0; j < stride; ++j)
+			{
+				const auto u = NextFloat(state);
+				const auto minValue = this->minValues[j];
+				const auto maxValue = this->maxValues[j];
+				const auto range = maxValue - minValue;
+				if (this->locks[j] || !std::isfinite(range) || range <= 0.0f)
+				{
+					// Unbounded parameters have no range to pick from.
+					variant[j] = this->base[j];
+					continue;
+				}
+
+				const auto amount = strength * this->strengths[j];
+				auto value = random ? this->base[j] + (minValue + u * range - this->base[j]) * amount
+					: this->base[j] + (u * 2.0f - 1.0f) * range * amount;
+				variant[j] = std::min(std::max(value, minValue), maxValue);
+			}
+		}
+	}
+
+	//--------------------------------------------------------------
+	bool Variations::getComponents(const ofAbstractParameter & parameter, int & offset, size_t & count) const
+	{
+		offset = this->store ? this->store->getOffset(parameter) : -1;
+		if (offset < 0)
+		{
+			ofLogWarning(__FUNCTION__) << "Parameter " << parameter.getName() << " is not stored!";
+			return false;
+		}
+		count = Binding::GetNumComponents(Binding::GetType(parameter));
+		return true;
+	}
+}